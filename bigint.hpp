@@ -5,6 +5,19 @@
 #include <cmath>
 #include <cctype>
 #include <string>
+#include <string_view>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
 using namespace std;
 
 /**
@@ -21,6 +34,20 @@ enum class sign
     positive
 };
 
+/**
+ * @brief Enumeration of the reasons why a string does not represent a bigint number, used by the parsing functions that do not throw exceptions.
+ *
+ * Each error corresponds to the bigint exception with the same name.
+ *
+ */
+enum class parse_error
+{
+    none,
+    empty_string,
+    non_digit,
+    leading_zeros
+};
+
 /**
  * @brief This class implements the arbitrary precision integers and allows simple arithmetic operations
  * between these integers.
@@ -32,20 +59,33 @@ public:
     bigint();
     bigint(const int64_t &);
     bigint(const string &);
-    /**
-     * @brief Construct a new bigint object with another (Default copy constructor)
-     *
-     */
-    // Start: define an explicit copy constructor to prevent a warning. Source: https://stackoverflow.com/questions/51863588/warning-definition-of-implicit-copy-constructor-is-deprecated
-    bigint(const bigint &) = default;
-    //
+    bigint(const bigint &);
+    ~bigint();
     void set(const int64_t &);
     void set(const string &);
+    parse_error try_set(const string_view &);
     bigint &operator=(const bigint &);
     bigint operator-() const;
     bigint &operator+=(const bigint &);
     bigint &operator-=(const bigint &);
     bigint &operator*=(const bigint &);
+    bigint &operator/=(const bigint &);
+    bigint &operator%=(const bigint &);
+    bigint isqrt() const;
+    bigint iroot(const uint64_t &) const;
+    bool is_perfect_square() const;
+    size_t hash() const;
+    void cache_string(const bool &enabled = true);
+    void reserve(const size_t &);
+    void shrink_to_fit();
+    size_t capacity() const;
+    size_t memory_usage() const;
+    string to_string(const unsigned &base = 10) const;
+    static bigint from_string(const string_view &, const unsigned &base = 10);
+    template <typename URBG>
+    static bigint random(const size_t &, URBG &);
+    template <typename URBG>
+    static bigint random(const bigint &, const bigint &, URBG &);
     bool operator==(const bigint &) const;
     bool operator<(const bigint &) const;
     friend ostream &operator<<(ostream &, const bigint &);
@@ -64,6 +104,78 @@ public:
      *
      */
     inline static invalid_argument empty_string = invalid_argument("The input string is empty!");
+    /**
+     * @brief Exception thrown when a bigint number is divided by zero.
+     *
+     */
+    inline static invalid_argument division_by_zero = invalid_argument("The divisor cannot be zero!");
+    /**
+     * @brief Exception thrown when an even root of a negative number is requested.
+     *
+     */
+    inline static invalid_argument negative_root = invalid_argument("An even root of a negative number is not defined!");
+    /**
+     * @brief Exception thrown when the root of degree zero is requested.
+     *
+     */
+    inline static invalid_argument zero_degree = invalid_argument("The degree of the root must be positive!");
+    /**
+     * @brief Exception thrown when a base outside of the range [2, 36] is given to `from_string` or `to_string`.
+     *
+     */
+    inline static invalid_argument invalid_base = invalid_argument("The base must be between 2 and 36!");
+    /**
+     * @brief Exception thrown when the lower bound of a range given to `random` is greater than its upper bound.
+     *
+     */
+    inline static invalid_argument empty_range = invalid_argument("The lower bound of the range cannot be greater than the upper bound!");
+    /**
+     * @brief Exception thrown by a computation when its `bigint_cancellation` token is cancelled.
+     *
+     */
+    inline static runtime_error cancelled = runtime_error("The computation was cancelled!");
+    /**
+     * @brief Crossover sizes between the algorithms used by bigint operations, which depend on the processor.
+     *
+     * The default values can be replaced by a tuning profile created by the `tune` tool, see `load` and `startup`.
+     *
+     */
+    struct tuning
+    {
+        /**
+         * @brief Multiplication uses Karatsuba's method when both operands have at least this many digits, and the schoolbook method otherwise.
+         * Values below 2 are treated as 2.
+         *
+         */
+        size_t karatsuba;
+        /**
+         * @brief Numbers with at most this many digits start the Newton iteration of `iroot` from a power of ten instead of the
+         * root of their leading digits.
+         *
+         */
+        size_t root_base_case;
+        /**
+         * @brief Product trees only use a new thread for ranges with at least this many numbers.
+         *
+         */
+        size_t parallel_product;
+        /**
+         * @brief `to_string` converts numbers with at most this many digits to bases other than 10 word by word, and splits longer
+         * numbers by dividing and conquering until the pieces are this short.
+         *
+         */
+        size_t conversion_base_case;
+        tuning();
+        bool load(const string &);
+        bool save(const string &) const;
+        static tuning startup();
+    };
+    /**
+     * @brief The thresholds used by all bigint operations. They are loaded at startup from the profile named by the `BIGINT_TUNING`
+     * environment variable, if any, and can be changed at any time before starting the computations that use them.
+     *
+     */
+    static tuning thresholds;
 
 private:
     /**
@@ -76,12 +188,420 @@ private:
      *
      */
     vector<uint8_t> digits;
-    void fill_digits(const string &);
-    bool is_digit(const string &) const;
+    /**
+     * @brief The hash of the number, computed on the first call to `hash` and reset by every member function that changes the number.
+     * Zero means that the hash has not been computed yet. It is atomic so that multiple threads can read the same number concurrently.
+     *
+     */
+    mutable atomic<size_t> cached_hash{0};
+    /**
+     * @brief Whether the decimal representation is cached, it is false unless `cache_string` is called. It is copied along with the
+     * value by both the copy constructor and the assignment operator.
+     *
+     */
+    bool string_caching = false;
+    /**
+     * @brief The decimal representation of the number, computed on the first call to `to_string` or `<<` if `string_caching` is true,
+     * and freed by every member function that changes the number. It is an atomic pointer so that multiple threads can fill it concurrently.
+     *
+     */
+    mutable atomic<const string *> cached_string{nullptr};
+    void clear_cache();
+    string decimal_string() const;
+    const string *cached_decimal() const;
     bool is_abs_greater(const bigint &) const;
+    void add_at(const bigint &, const size_t &);
+    void subtract_abs(const bigint &);
+    void subtract_abs_from(const bigint &);
     void zero_remover();
+    void shift_left(const size_t &);
+    void shift_right(const size_t &);
+    uint64_t divide_small(const uint64_t &);
+    uint64_t remainder_small(const uint64_t &) const;
+    void divide(const bigint &, bigint &, bigint &) const;
+    static bool is_square_residue(const uint64_t &, const uint64_t &);
+    void multiply_low(const bigint &, const bigint &, const size_t &);
+    void multiply_low(const bigint &, const bigint &, const size_t &, vector<uint64_t> &);
+    static void karatsuba(const bigint &, const bigint &, bigint &);
+    void split(const size_t &, bigint &, bigint &) const;
+    template <typename URBG>
+    void random_digits(const size_t &, const unsigned &, const unsigned &, URBG &);
+    static unsigned digit_value(const char &);
+    static size_t word_length(const unsigned &, const uint64_t &);
+    static bigint combine_words(const vector<uint64_t> &, const size_t &, const size_t &, vector<bigint> &);
+    static bigint reciprocal(const bigint &);
+    static void split_words(const bigint &, const size_t &, const vector<bigint> &, vector<bigint> &, const uint64_t &, vector<uint64_t> &, const size_t &);
+    friend class bigint_modulus;
+    friend class bigint_rns;
+};
+
+/**
+ * @brief A token to cancel an asynchronous bigint computation and to read its progress.
+ *
+ * Copies of a token share the same state, so the caller can keep one copy and pass another to `async_multiply`, `async_divide`,
+ * `async_power` or `async_to_string`. Cancellation is cooperative: the computation checks the token regularly in its loops and
+ * throws `bigint::cancelled`, which is then rethrown by the `get` function of its future.
+ *
+ */
+class bigint_cancellation
+{
+public:
+    bigint_cancellation();
+    void cancel();
+    bool is_cancelled() const;
+    double progress() const;
+
+private:
+    /**
+     * @brief The state shared between the copies of a token.
+     *
+     */
+    struct state
+    {
+        atomic<bool> cancelled{false};
+        atomic<double> progress{0};
+    };
+    shared_ptr<state> shared;
+    friend class bigint_progress;
+};
+
+/**
+ * @brief A scope of a long computation that reports its progress and checks for cancellation.
+ *
+ * An asynchronous computation installs a top-level scope on its thread, which covers the progress from 0 to 1. Each kernel (such as
+ * a multiplication or a division) opens a nested scope, which covers the part of its parent's range that was current when it was
+ * opened, and calls `step` as it goes. So a kernel does not need to know whether it is the whole computation or a small part of it.
+ * When no computation is installed on the thread, the scopes do nothing.
+ *
+ */
+class bigint_progress
+{
+public:
+    bigint_progress();
+    bigint_progress(const bigint_cancellation &, const function<void(double)> &);
+    bigint_progress(const bigint_progress &) = delete;
+    bigint_progress &operator=(const bigint_progress &) = delete;
+    ~bigint_progress();
+    void step(const size_t &, const size_t &);
+
+private:
+    /**
+     * @brief The state of the computation running on the current thread.
+     *
+     */
+    struct context
+    {
+        bigint_cancellation token;
+        function<void(double)> callback;
+        /**
+         * @brief The start and the length of the range of progress given to the next nested scope.
+         *
+         */
+        double base = 0;
+        double span = 1;
+        /**
+         * @brief The last progress that was reported.
+         *
+         */
+        double reported = 0;
+    };
+    /**
+     * @brief The computation running on the current thread, if any.
+     *
+     */
+    inline static thread_local context *current = nullptr;
+    /**
+     * @brief The context owned by a top-level scope, and the one it replaced on the thread.
+     *
+     */
+    unique_ptr<context> owned;
+    context *previous = nullptr;
+    /**
+     * @brief The range of progress covered by this scope.
+     *
+     */
+    double base = 0;
+    double span = 1;
 };
 
+/**
+ * @brief Construct a new bigint_cancellation token, which is not cancelled and has no progress.
+ *
+ */
+bigint_cancellation::bigint_cancellation()
+{
+    shared = make_shared<state>();
+}
+
+/**
+ * @brief Requests the computations using this token to stop as soon as possible.
+ *
+ */
+void bigint_cancellation::cancel()
+{
+    shared->cancelled.store(true);
+}
+
+/**
+ * @brief Checks whether the token has been cancelled.
+ *
+ * @return true If `cancel` has been called on this token or a copy of it.
+ * @return false Otherwise.
+ */
+bool bigint_cancellation::is_cancelled() const
+{
+    return shared->cancelled.load();
+}
+
+/**
+ * @brief Returns the progress of the computation using this token.
+ *
+ * @return double The fraction of the computation that has been done, between 0 and 1.
+ */
+double bigint_cancellation::progress() const
+{
+    return shared->progress.load();
+}
+
+/**
+ * @brief Opens a nested scope, which covers the range of progress given by the innermost scope of the current computation.
+ *
+ */
+bigint_progress::bigint_progress()
+{
+    if (current != nullptr)
+    {
+        base = current->base;
+        span = current->span;
+    }
+}
+
+/**
+ * @brief Opens the top-level scope of a computation on the current thread, which covers the whole range of progress.
+ *
+ * @param token The token to be checked for cancellation and to store the progress in.
+ * @param callback A function to be called with the progress whenever it increases by at least 1%, it may be empty.
+ */
+bigint_progress::bigint_progress(const bigint_cancellation &token, const function<void(double)> &callback)
+{
+    owned = make_unique<context>();
+    owned->token = token;
+    owned->callback = callback;
+    previous = current;
+    current = owned.get();
+}
+
+/**
+ * @brief Closes the scope, giving the range of progress back to its parent, or uninstalling the computation if it is the top-level scope.
+ *
+ */
+bigint_progress::~bigint_progress()
+{
+    if (owned)
+        current = previous;
+    else if (current != nullptr)
+    {
+        current->base = base;
+        current->span = span;
+    }
+}
+
+/**
+ * @brief Reports that a scope has done `done` out of `total` steps, and throws `bigint::cancelled` if the computation is cancelled.
+ *
+ * The nested scopes opened until the next step cover the range of progress of the next step.
+ *
+ * @param done The number of steps done.
+ * @param total The total number of steps of this scope.
+ */
+void bigint_progress::step(const size_t &done, const size_t &total)
+{
+    if (current == nullptr)
+        return;
+    if (current->token.is_cancelled())
+        throw bigint::cancelled;
+    double fraction = base + span * static_cast<double>(done) / static_cast<double>(total);
+    current->base = fraction;
+    current->span = span / static_cast<double>(total);
+    if (fraction >= current->reported + 0.01 or (done == total and fraction > current->reported))
+    {
+        current->reported = fraction;
+        current->token.shared->progress.store(fraction);
+        if (current->callback)
+            current->callback(fraction);
+    }
+}
+
+/**
+ * @brief Construct a new bigint::tuning object with the compiled-in default thresholds.
+ *
+ */
+bigint::tuning::tuning()
+{
+    karatsuba = 96;
+    root_base_case = 32;
+    parallel_product = 16;
+    conversion_base_case = 1000000;
+}
+
+/**
+ * @brief Reads the thresholds from a tuning profile.
+ *
+ * A profile is a text file with one `name value` pair per line, such as `karatsuba 48`; empty lines and lines starting with `#` are
+ * ignored, and so are unknown names. Every value must be a positive integer with nothing after it on the line (a minus sign is not
+ * accepted, since it would wrap around), and `karatsuba` must be at least 2, since Karatsuba's method cannot split single digits. The
+ * thresholds are only changed if the whole file is valid.
+ *
+ * @param path The path of the tuning profile.
+ * @return true If the profile was read successfully.
+ * @return false If the file could not be opened or contains an invalid line, in which case the thresholds are not changed.
+ */
+bool bigint::tuning::load(const string &path)
+{
+    ifstream input(path);
+    if (!input.is_open())
+        return false;
+    tuning loaded = *this;
+    string line;
+    while (getline(input, line))
+    {
+        if (line.empty() or line[0] == '#')
+            continue;
+        istringstream fields(line);
+        string name;
+        size_t value;
+        if (!(fields >> name >> ws) or fields.peek() == '-' or !(fields >> value))
+            return false;
+        fields >> ws;
+        if (!fields.eof() or value == 0 or (name == "karatsuba" and value < 2))
+            return false;
+        if (name == "karatsuba")
+            loaded.karatsuba = value;
+        else if (name == "root_base_case")
+            loaded.root_base_case = value;
+        else if (name == "parallel_product")
+            loaded.parallel_product = value;
+        else if (name == "conversion_base_case")
+            loaded.conversion_base_case = value;
+    }
+    *this = loaded;
+    return true;
+}
+
+/**
+ * @brief Writes the thresholds to a tuning profile that can be read by `load`.
+ *
+ * @param path The path of the tuning profile.
+ * @return true If the profile was written successfully.
+ * @return false If the file could not be written.
+ */
+bool bigint::tuning::save(const string &path) const
+{
+    ofstream output(path);
+    if (!output.is_open())
+        return false;
+    output << "# bigint tuning profile\n";
+    output << "karatsuba " << karatsuba << '\n';
+    output << "root_base_case " << root_base_case << '\n';
+    output << "parallel_product " << parallel_product << '\n';
+    output << "conversion_base_case " << conversion_base_case << '\n';
+    return output.good();
+}
+
+/**
+ * @brief Returns the thresholds to be used when the program starts.
+ *
+ * If the `BIGINT_TUNING` environment variable names a valid tuning profile, its thresholds are used, otherwise the compiled-in defaults.
+ *
+ * @return bigint::tuning The thresholds for the current machine.
+ */
+bigint::tuning bigint::tuning::startup()
+{
+    tuning defaults;
+    const char *path = getenv("BIGINT_TUNING");
+    if (path != nullptr)
+        defaults.load(path);
+    return defaults;
+}
+
+inline bigint::tuning bigint::thresholds = bigint::tuning::startup();
+
+/**
+ * @brief Sets the current bigint number to a random positive number with a given number of digits, drawn from a random generator.
+ *
+ * The digits are written directly into `digits`: each call of the generator gives a uniform word below 10^19, which fills 19 digits.
+ * The most significant digit is drawn separately from a given range. If it may be zero, the number may have fewer digits.
+ *
+ * @param length The number of digits, it must be positive.
+ * @param lowest The lowest value of the most significant digit.
+ * @param highest The highest value of the most significant digit.
+ * @param generator A uniform random bit generator, such as `mt19937_64`.
+ */
+template <typename URBG>
+void bigint::random_digits(const size_t &length, const unsigned &lowest, const unsigned &highest, URBG &generator)
+{
+    clear_cache();
+    digits.resize(length);
+    uniform_int_distribution<uint64_t> words(0, 9999999999999999999ULL);
+    for (size_t i = 0; i + 1 < length; i += 19)
+    {
+        uint64_t word = words(generator);
+        for (size_t j = i; j < min(i + 19, length - 1); j++)
+        {
+            digits[j] = static_cast<uint8_t>(word % 10);
+            word /= 10;
+        }
+    }
+    digits[length - 1] = static_cast<uint8_t>(uniform_int_distribution<unsigned>(lowest, highest)(generator));
+    number_sign = sign::positive;
+    zero_remover();
+}
+
+/**
+ * @brief Creates a uniformly random positive bigint number with exactly a given number of digits.
+ *
+ * @param length The number of digits, if it is zero the result is zero.
+ * @param generator A uniform random bit generator, such as `mt19937_64`.
+ * @return bigint A random number between 10^(length - 1) and 10^length - 1.
+ */
+template <typename URBG>
+bigint bigint::random(const size_t &length, URBG &generator)
+{
+    bigint result;
+    if (length > 0)
+        result.random_digits(length, 1, 9, generator);
+    return result;
+}
+
+/**
+ * @brief Creates a uniformly random bigint number in a range, with rejection sampling.
+ *
+ * A number x between zero and the width of the range (high - low) is drawn with the same number of digits as the width, where the most
+ * significant digit is at most the most significant digit of the width. x is drawn again while it is greater than the width, which
+ * happens less than half of the time. It throws `empty_range` if `low` is greater than `high`.
+ *
+ * @param low The lower bound of the range, inclusive.
+ * @param high The upper bound of the range, inclusive.
+ * @param generator A uniform random bit generator, such as `mt19937_64`.
+ * @return bigint A random number between `low` and `high`.
+ */
+template <typename URBG>
+bigint bigint::random(const bigint &low, const bigint &high, URBG &generator)
+{
+    if (high < low)
+        throw empty_range;
+    bigint width = high;
+    width -= low;
+    if (width.number_sign == sign::zero)
+        return low;
+    bigint result;
+    do
+        result.random_digits(width.digits.size(), 0, width.digits.back(), generator);
+    while (width < result);
+    result += low;
+    return result;
+}
+
 /**
  * @brief Sets the current bigint number to a signed 64-bit integer number.
  *
@@ -89,6 +609,7 @@ private:
  */
 void bigint::set(const int64_t &number)
 {
+    clear_cache();
     if (number == 0)
     {
         digits.clear();
@@ -117,54 +638,77 @@ void bigint::set(const int64_t &number)
             temp = temp / 10;
             cursor++;
         }
+        // The logarithm is computed in double precision and overestimates the length of numbers such as 10^18 - 1.
+        digits.resize(cursor);
     }
 }
 
 /**
  * @brief Sets the current bigint object to the value represented by a string.
  *
- * It parses the string, assuming it represents a decimal integer number and throws an exception when the number contains non-digit
- * characters, has leading zeros or the string is empty. It will also parse the sign of the number and assign the `bigint::number_sign` accordingly.
+ * It parses the string with `try_set`, assuming it represents a decimal integer number and throws an exception when the number contains
+ * non-digit characters, has leading zeros or the string is empty. In that case, the current object is not changed.
  *
  * @param input_string An input string representing a bigint number to set the value of current object with.
  */
 void bigint::set(const string &input_string)
 {
-    if (input_string.empty())
-        throw empty_string;
-    if (input_string == "+0" or input_string == "-0")
+    switch (try_set(input_string))
     {
-        digits.clear();
-        number_sign = sign::zero;
-        digits.push_back(0);
+    case parse_error::empty_string:
+        throw empty_string;
+    case parse_error::non_digit:
+        throw non_digit;
+    case parse_error::leading_zeros:
+        throw leading_zeros;
+    case parse_error::none:
+        break;
     }
+}
 
-    if (input_string[0] == '0')
-    {
-        if (input_string.length() == 1)
-        {
-            digits.clear();
-            number_sign = sign::zero;
-            digits.push_back(0);
-        }
-        else
-            throw leading_zeros;
-    }
-    else if (input_string[0] == '-')
-    {
-        fill_digits(input_string.substr(1, input_string.length() - 1));
-        number_sign = sign::negative;
-    }
-    else if (input_string[0] == '+')
+/**
+ * @brief Sets the current bigint object to the value represented by a string, and returns an error code instead of throwing an exception.
+ *
+ * An optional `+` or `-` sign may precede the digits. The number cannot have leading zeros, except for zero itself, which may also be
+ * written as `+0` or `-0`. The characters are checked with a plain range comparison rather than `isdigit`, so the result does not depend
+ * on the locale. If the string is invalid, the current object is not changed.
+ *
+ * @param input A string view representing a bigint number, it does not need to be a null-terminated string.
+ * @return parse_error `parse_error::none` if the number was set, or the reason why the string is invalid.
+ */
+parse_error bigint::try_set(const string_view &input)
+{
+    if (input.empty())
+        return parse_error::empty_string;
+    size_t start = 0;
+    if (input[0] == '+' or input[0] == '-')
+        start = 1;
+    size_t length = input.size() - start;
+    if (length == 0)
+        return parse_error::non_digit;
+    if (input[start] == '0' and length > 1)
+        return parse_error::leading_zeros;
+    for (size_t i = start; i < input.size(); i++)
+        if (input[i] < '0' or input[i] > '9')
+            return parse_error::non_digit;
+
+    clear_cache();
+    if (input[start] == '0')
     {
-        fill_digits(input_string.substr(1, input_string.length() - 1));
-        number_sign = sign::positive;
+        number_sign = sign::zero;
+        digits = {0};
+        return parse_error::none;
     }
-    else
+    number_sign = input[0] == '-' ? sign::negative : sign::positive;
+    digits.resize(length);
+    for (size_t i = 0; i < length; i++)
     {
-        fill_digits(input_string);
-        number_sign = sign::positive;
+        // Start: Convert char to int, source: https://sentry.io/answers/char-to-int-in-c-and-cpp/
+        //        Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
+        digits[i] = static_cast<uint8_t>(input[input.size() - i - 1] - '0');
+        // End
     }
+    return parse_error::none;
 }
 
 /**
@@ -198,47 +742,27 @@ bigint::bigint(const string &input_string)
 }
 
 /**
- * @brief Checks whether a string represents a number.
+ * @brief Construct a new bigint::bigint object with a copy of another bigint number.
  *
- * @param input_string An input string to be checked.
- * @return true If all the characters in the string are digits.
- * @return false If the string has any non-digit characters.
+ * The value and the `string_caching` flag are copied, but the cached hash and string of `other` are not. This constructor has to be
+ * defined explicitly because the atomic `bigint::cached_hash` and `bigint::cached_string` members cannot be copied.
+ *
+ * @param other The bigint number to be copied.
  */
-// Start: check a string with character classification functions, source https://baraksh.com/CSE701/notes.php#io-error-handling
-bool bigint::is_digit(const string &input_string) const
+bigint::bigint(const bigint &other)
 {
-    for (const char &c : input_string)
-        if (!isdigit(c))
-            return false;
-    return true;
+    number_sign = other.number_sign;
+    digits = other.digits;
+    string_caching = other.string_caching;
 }
-// End
 
 /**
- * @brief Parses a string representing a bigint number and fills it in the `bigint::digits` vector.
- *
- * This function checks the validity of `input_string` and ensures it only contains digit characters.
- * Then it fill fill out the `bigint::digits` vector in a reverse order, meaning that the least significant
- * digit will be filled into the first element of vector.
+ * @brief Destroy the bigint::bigint object and free its cached string.
  *
- * @param input_string An input string representing a bigint number.
  */
-void bigint::fill_digits(const string &input_string)
+bigint::~bigint()
 {
-    if (input_string[0] == '0')
-        throw leading_zeros;
-    else if (!is_digit(input_string))
-        throw non_digit;
-
-    digits.resize(input_string.length());
-
-    for (size_t i = 0; i < input_string.length(); i++)
-    {
-        // Start: Convert char to int, source: https://sentry.io/answers/char-to-int-in-c-and-cpp/
-        //        Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-        digits[i] = static_cast<uint8_t>(input_string[input_string.length() - i - 1] - '0');
-        // End
-    }
+    delete cached_string.load(memory_order_acquire);
 }
 
 /**
@@ -265,6 +789,11 @@ bigint bigint::operator-() const
  */
 ostream &operator<<(ostream &out, const bigint &number)
 {
+    if (number.string_caching)
+    {
+        out << *number.cached_decimal();
+        return out;
+    }
     if (number.number_sign == sign::zero)
     {
         out << '0';
@@ -422,6 +951,8 @@ bool operator<=(const bigint &lhs, const bigint &rhs)
 /**
  * @brief Assigns the value of another bigint number to the current number.
  *
+ * Like the copy constructor, it copies the value and the `string_caching` flag, but not the cached hash and string of `other`.
+ *
  * @param other The value to be assigned to the current number.
  * @return bigint& A reference to the modified bigint number.
  */
@@ -431,8 +962,10 @@ bigint &bigint::operator=(const bigint &other)
     if (this != &other)
     // End
     {
+        clear_cache();
         digits = other.digits;
         number_sign = other.number_sign;
+        string_caching = other.string_caching;
     }
     return *this;
 }
@@ -445,49 +978,27 @@ bigint &bigint::operator=(const bigint &other)
  */
 bigint &bigint::operator+=(const bigint &other)
 {
+    clear_cache();
     if (other.number_sign == sign::zero)
         return *this;
     else if (number_sign == sign::zero)
         *this = other;
     else if (number_sign == other.number_sign)
     {
-        size_t max_length = max(digits.size(), other.digits.size());
-        uint8_t carry = 0;
-        for (size_t i = 0; i < max_length; i++)
-        {
-            if (i >= digits.size())
-            {
-                uint8_t temp = other.digits[i] + carry;
-                carry = temp / 10;
-                digits.push_back(temp % 10);
-            }
-            else if (i >= other.digits.size())
-            {
-                uint8_t temp = digits[i] + carry;
-                carry = temp / 10;
-                digits[i] = temp % 10;
-            }
-            else
-            {
-                // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-                uint8_t temp = static_cast<uint8_t>(digits[i] + other.digits[i] + carry);
-                // End
-                carry = temp / 10;
-                digits[i] = temp % 10;
-            }
-        }
-        if (carry > 0)
-            digits.push_back(carry);
+        digits.reserve(max(digits.size(), other.digits.size()) + 1);
+        add_at(other, 0);
     }
-    else if (number_sign == sign::positive and other.number_sign == sign::negative)
+    else if (is_abs_greater(other))
+        subtract_abs(other);
+    else if (other.is_abs_greater(*this))
     {
-        *this -= -other;
+        subtract_abs_from(other);
+        number_sign = other.number_sign;
     }
-    else if (number_sign == sign::negative and other.number_sign == sign::positive)
+    else
     {
-        bigint temp = other;
-        temp -= -*this;
-        *this = temp;
+        number_sign = sign::zero;
+        digits.assign(1, 0);
     }
     return *this;
 }
@@ -531,14 +1042,18 @@ bool bigint::is_abs_greater(const bigint &other) const
 
 /**
  * @brief Removes leading zeros of a bigint object.‍ It will iterate the digits starting from the most significant digit, and remove any leading zeros in the start, if available.
+ * If all the digits were zero, the number becomes zero.
  *
  */
 void bigint::zero_remover()
 {
+    clear_cache();
     if (number_sign == sign::zero)
         return;
-    while (digits[digits.size() - 1] == 0)
+    while (digits.size() > 1 and digits[digits.size() - 1] == 0)
         digits.pop_back();
+    if (digits[0] == 0 and digits.size() == 1)
+        number_sign = sign::zero;
 }
 
 /**
@@ -549,96 +1064,125 @@ void bigint::zero_remover()
  */
 bigint &bigint::operator-=(const bigint &other)
 {
+    clear_cache();
     if (other.number_sign == sign::zero)
         return *this;
     else if (number_sign == sign::zero)
-        *this = -other;
-    else if (*this == other)
-        *this = bigint();
-    else if (number_sign == other.number_sign)
     {
-        if (this->is_abs_greater(other))
-        {
-            uint8_t borrow = 0;
-            for (size_t i = 0; i < digits.size(); i++)
-            {
-                int16_t temp = digits[i];
-                if (borrow > 0)
-                {
-                    temp -= 1;
-                    if (temp < 0)
-                    {
-                        temp += 10;
-                        borrow = 1;
-                    }
-                    else
-                        borrow = 0;
-                }
-                if (i < other.digits.size())
-                    temp -= other.digits[i];
-                if (temp < 0)
-                {
-                    temp += 10;
-                    borrow = 1;
-                }
-                // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-                digits[i] = static_cast<uint8_t>(temp);
-                // End
-            }
-            this->zero_remover();
-            return *this;
-        }
-        else if (!this->is_abs_greater(other))
-        {
-            bigint _other = other;
-            uint8_t borrow = 0;
-            for (size_t i = 0; i < _other.digits.size(); i++)
-            {
-                int16_t temp = _other.digits[i];
-                if (borrow > 0)
-                {
-                    temp -= 1;
-                    if (temp < 0)
-                    {
-                        temp += 10;
-                        borrow = 1;
-                    }
-                    else
-                        borrow = 0;
-                }
-                if (i < digits.size())
-                    temp -= digits[i];
-                if (temp < 0)
-                {
-                    temp += 10;
-                    borrow = 1;
-                }
-                // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-                _other.digits[i] = static_cast<uint8_t>(temp);
-                // End
-            }
-            _other.zero_remover();
-            if (number_sign == sign::positive)
-                number_sign = sign::negative;
-            else
-                number_sign = sign::positive;
-            digits = _other.digits;
-            return *this;
-        }
+        *this = other;
+        number_sign = other.number_sign == sign::positive ? sign::negative : sign::positive;
+    }
+    else if (number_sign != other.number_sign)
+    {
+        digits.reserve(max(digits.size(), other.digits.size()) + 1);
+        add_at(other, 0);
     }
-    else if (number_sign == sign::positive and other.number_sign == sign::negative)
+    else if (is_abs_greater(other))
+        subtract_abs(other);
+    else if (other.is_abs_greater(*this))
     {
-        *this += -other;
+        subtract_abs_from(other);
+        number_sign = number_sign == sign::positive ? sign::negative : sign::positive;
     }
-    else if (number_sign == sign::negative and other.number_sign == sign::positive)
+    else
     {
-        bigint temp = other;
-        temp += -*this;
-        *this = -temp;
+        number_sign = sign::zero;
+        digits.assign(1, 0);
     }
     return *this;
 }
 
+/**
+ * @brief Adds the absolute value of another bigint number, shifted left by some digits, to the absolute value of the current number.
+ *
+ * The digits are only resized if the shifted number is longer than the current one, and a final carry is pushed back. It does not
+ * change the sign, so the current number must be non-zero, or have digits filled with zeros and a positive sign.
+ *
+ * @param other The number to be added, it may be the current number itself only if the offset is zero.
+ * @param offset The number of digits to shift the other number by, i.e. it is multiplied by 10^offset.
+ */
+void bigint::add_at(const bigint &other, const size_t &offset)
+{
+    clear_cache();
+    if (other.number_sign == sign::zero)
+        return;
+    size_t length = other.digits.size();
+    if (digits.size() < offset + length)
+    {
+        digits.reserve(offset + length + 1);
+        digits.resize(offset + length, 0);
+    }
+    uint8_t carry = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
+        uint8_t temp = static_cast<uint8_t>(digits[offset + i] + other.digits[i] + carry);
+        // End
+        carry = temp / 10;
+        digits[offset + i] = temp % 10;
+    }
+    for (size_t i = offset + length; carry > 0; i++)
+    {
+        if (i == digits.size())
+            digits.push_back(0);
+        uint8_t temp = static_cast<uint8_t>(digits[i] + carry);
+        carry = temp / 10;
+        digits[i] = temp % 10;
+    }
+}
+
+/**
+ * @brief Subtracts the absolute value of another bigint number from the absolute value of the current number, in place.
+ *
+ * @param other A number whose absolute value is less than the absolute value of the current number.
+ */
+void bigint::subtract_abs(const bigint &other)
+{
+    clear_cache();
+    uint8_t borrow = 0;
+    for (size_t i = 0; i < other.digits.size(); i++)
+    {
+        int16_t temp = static_cast<int16_t>(digits[i] - other.digits[i] - borrow);
+        borrow = temp < 0 ? 1 : 0;
+        // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
+        digits[i] = static_cast<uint8_t>(temp + 10 * borrow);
+        // End
+    }
+    for (size_t i = other.digits.size(); borrow > 0; i++)
+    {
+        borrow = digits[i] == 0 ? 1 : 0;
+        digits[i] = static_cast<uint8_t>(borrow > 0 ? 9 : digits[i] - 1);
+    }
+    zero_remover();
+}
+
+/**
+ * @brief Replaces the absolute value of the current bigint number with the absolute value of another number minus it, in place.
+ * The digits are resized once to the length of the other number.
+ *
+ * @param other A number whose absolute value is greater than the absolute value of the current number.
+ */
+void bigint::subtract_abs_from(const bigint &other)
+{
+    clear_cache();
+    size_t length = digits.size();
+    digits.resize(other.digits.size(), 0);
+    uint8_t borrow = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        int16_t temp = static_cast<int16_t>(other.digits[i] - digits[i] - borrow);
+        borrow = temp < 0 ? 1 : 0;
+        digits[i] = static_cast<uint8_t>(temp + 10 * borrow);
+    }
+    for (size_t i = length; i < digits.size(); i++)
+    {
+        int16_t temp = static_cast<int16_t>(other.digits[i] - borrow);
+        borrow = temp < 0 ? 1 : 0;
+        digits[i] = static_cast<uint8_t>(temp + 10 * borrow);
+    }
+    zero_remover();
+}
+
 /**
  * @brief Subtracts two bigint numbers.
  *
@@ -655,11 +1199,14 @@ bigint operator-(bigint lhs, const bigint &rhs)
 /**
  * @brief Multiplies the current bigint number by another and stores the result in the current object.
  *
+ * The absolute values are multiplied by `karatsuba`, which uses the schoolbook method for small numbers.
+ *
  * @param other The other bigint number (multiplicand).
  * @return bigint& A reference to the current object after multiplication.
  */
 bigint &bigint::operator*=(const bigint &other)
 {
+    clear_cache();
     if (number_sign == sign::zero or other.number_sign == sign::zero)
     {
         number_sign = sign::zero;
@@ -679,65 +1226,2231 @@ bigint &bigint::operator*=(const bigint &other)
     else if (other.digits.size() == 1 and other.digits[0] == 1)
         return *this;
 
-    if (digits.size() >= other.digits.size())
+    bigint result;
+    karatsuba(*this, other, result);
+    digits.swap(result.digits);
+    return *this;
+}
+
+/**
+ * @brief Multiplies two bigint numbers.
+ *
+ * @param lhs The left-hand side operand (multiplier).
+ * @param rhs The right-hand side operand (multiplicand).
+ * @return bigint A copy of the result after multiplication.
+ */
+bigint operator*(bigint lhs, const bigint &rhs)
+{
+    lhs *= rhs;
+    return lhs;
+}
+
+/**
+ * @brief Multiplies the current bigint number by 10^k, by inserting k zeros in the least significant digits.
+ *
+ * @param k The number of decimal places to shift the number by.
+ */
+void bigint::shift_left(const size_t &k)
+{
+    clear_cache();
+    if (number_sign == sign::zero or k == 0)
+        return;
+    digits.insert(digits.begin(), k, 0);
+}
+
+/**
+ * @brief Divides the current bigint number by 10^k, by removing its k least significant digits (the result is truncated towards zero).
+ *
+ * @param k The number of decimal places to shift the number by.
+ */
+void bigint::shift_right(const size_t &k)
+{
+    clear_cache();
+    if (number_sign == sign::zero or k == 0)
+        return;
+    if (k >= digits.size())
+    {
+        number_sign = sign::zero;
+        digits = {0};
+    }
+    else
+        digits.erase(digits.begin(), digits.begin() + static_cast<ptrdiff_t>(k));
+}
+
+/**
+ * @brief Divides the absolute value of the current bigint number by a small positive integer in place.
+ *
+ * The digits are processed from the most significant one, carrying the remainder of each step to the next, just like the
+ * short division taught in elementary schools. The divisor must be less than 2^60 so that the running remainder does not overflow.
+ *
+ * @param divisor A positive integer to divide the number by.
+ * @return uint64_t The remainder of the division.
+ */
+uint64_t bigint::divide_small(const uint64_t &divisor)
+{
+    clear_cache();
+    if (number_sign == sign::zero)
+        return 0;
+    uint64_t remainder = 0;
+    for (size_t i = digits.size(); i > 0; i--)
+    {
+        uint64_t current = remainder * 10 + digits[i - 1];
+        digits[i - 1] = static_cast<uint8_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    zero_remover();
+    return remainder;
+}
+
+/**
+ * @brief Computes the remainder of the absolute value of the current bigint number modulo a small positive integer, without modifying it.
+ *
+ * @param divisor A positive integer less than 2^60.
+ * @return uint64_t The remainder of the division.
+ */
+uint64_t bigint::remainder_small(const uint64_t &divisor) const
+{
+    uint64_t remainder = 0;
+    for (size_t i = digits.size(); i > 0; i--)
+        remainder = (remainder * 10 + digits[i - 1]) % divisor;
+    return remainder;
+}
+
+/**
+ * @brief Divides the absolute value of the current bigint number by the absolute value of another using long division.
+ *
+ * The quotient is built one digit at a time, starting from the most significant digit of the dividend. In each step the next digit
+ * is brought down into the running remainder, and the largest multiple of the divisor (zero to nine times the divisor) that does not
+ * exceed the remainder gives the next digit of the quotient. The nine multiples are computed once before the loop.
+ *
+ * @param other The divisor, it must not be zero.
+ * @param quotient The absolute value of the quotient.
+ * @param remainder The absolute value of the remainder.
+ */
+void bigint::divide(const bigint &other, bigint &quotient, bigint &remainder) const
+{
+    quotient = bigint();
+    remainder = bigint();
+    if (number_sign == sign::zero)
+        return;
+    if (other.is_abs_greater(*this))
+    {
+        remainder = *this;
+        remainder.number_sign = sign::positive;
+        return;
+    }
+
+    vector<bigint> multiples(10);
+    multiples[1] = other;
+    multiples[1].number_sign = sign::positive;
+    for (size_t i = 2; i < 10; i++)
     {
-        bigint result;
-        for (size_t i = 0; i < other.digits.size(); i++)
+        multiples[i] = multiples[i - 1];
+        multiples[i] += multiples[1];
+    }
+
+    quotient.digits.assign(digits.size(), 0);
+    quotient.number_sign = sign::positive;
+    remainder.digits.reserve(other.digits.size() + 1);
+    bigint_progress progress;
+    for (size_t i = digits.size(); i > 0; i--)
+    {
+        progress.step(digits.size() - i, digits.size());
+        if (remainder.number_sign != sign::zero)
+            remainder.digits.insert(remainder.digits.begin(), digits[i - 1]);
+        else if (digits[i - 1] != 0)
         {
-            uint8_t carry = 0;
-            bigint temp;
-            temp.digits.resize(i, 0);
-            for (size_t j = 0; j < digits.size(); j++)
-            {
-                // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-                uint8_t multiply = static_cast<uint8_t>(digits[j] * other.digits[i] + carry);
-                // End
-                carry = multiply / 10;
-                temp.digits.push_back(multiply % 10);
-            }
-            if (carry > 0)
-                temp.digits.push_back(carry);
-            temp.number_sign = sign::positive;
-            result += temp;
+            remainder.digits[0] = digits[i - 1];
+            remainder.number_sign = sign::positive;
         }
-        digits = result.digits;
+        uint8_t q = 0;
+        while (q < 9 and !multiples[q + 1].is_abs_greater(remainder))
+            q++;
+        if (q > 0)
+            remainder -= multiples[q];
+        quotient.digits[i - 1] = q;
+    }
+    quotient.zero_remover();
+}
+
+/**
+ * @brief Divides the current bigint number by another and stores the quotient in the current object.
+ *
+ * Just like the built-in integer types, the quotient is truncated towards zero. It throws `division_by_zero` if the divisor is zero.
+ *
+ * @param other The other bigint number (divisor).
+ * @return bigint& A reference to the current object after division.
+ */
+bigint &bigint::operator/=(const bigint &other)
+{
+    clear_cache();
+    if (other.number_sign == sign::zero)
+        throw division_by_zero;
+    bigint quotient, remainder;
+    divide(other, quotient, remainder);
+    if (quotient.number_sign != sign::zero and number_sign != other.number_sign)
+        quotient.number_sign = sign::negative;
+    *this = quotient;
+    return *this;
+}
+
+/**
+ * @brief Divides two bigint numbers.
+ *
+ * @param lhs The left-hand side operand (dividend).
+ * @param rhs The right-hand side operand (divisor).
+ * @return bigint A copy of the result after division.
+ */
+bigint operator/(bigint lhs, const bigint &rhs)
+{
+    lhs /= rhs;
+    return lhs;
+}
+
+/**
+ * @brief Computes the remainder of dividing the current bigint number by another and stores it in the current object.
+ *
+ * Just like the built-in integer types, the remainder has the same sign as the dividend. It throws `division_by_zero` if the divisor is zero.
+ *
+ * @param other The other bigint number (divisor).
+ * @return bigint& A reference to the current object after the operation.
+ */
+bigint &bigint::operator%=(const bigint &other)
+{
+    clear_cache();
+    if (other.number_sign == sign::zero)
+        throw division_by_zero;
+    bigint quotient, remainder;
+    divide(other, quotient, remainder);
+    if (remainder.number_sign != sign::zero and number_sign == sign::negative)
+        remainder.number_sign = sign::negative;
+    *this = remainder;
+    return *this;
+}
+
+/**
+ * @brief Computes the remainder of dividing two bigint numbers.
+ *
+ * @param lhs The left-hand side operand (dividend).
+ * @param rhs The right-hand side operand (divisor).
+ * @return bigint A copy of the remainder.
+ */
+bigint operator%(bigint lhs, const bigint &rhs)
+{
+    lhs %= rhs;
+    return lhs;
+}
+
+/**
+ * @brief Raises a bigint number to a non-negative integer power using binary exponentiation (repeated squaring).
+ *
+ * @param base The bigint number to be raised to a power.
+ * @param exponent A non-negative integer exponent.
+ * @return bigint The result of `base` to the power of `exponent`, where zero to the power of zero is one.
+ */
+bigint power(bigint base, const uint64_t &exponent)
+{
+    bigint result(1);
+    uint64_t remaining = exponent;
+    size_t bits = 0;
+    for (uint64_t i = exponent; i > 0; i /= 2)
+        bits++;
+    bigint_progress progress;
+    for (size_t bit = 0; remaining > 0; bit++)
+    {
+        progress.step(bit, bits);
+        if (remaining % 2 == 1)
+            result *= base;
+        remaining /= 2;
+        if (remaining > 0)
+            base *= base;
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the integer n-th root of the current bigint number, which is the root truncated towards zero.
+ *
+ * It uses the Newton iteration x = ((n - 1) * x + N / x^(n - 1)) / n, which decreases monotonically to the root when it starts from
+ * a value not less than the root. To double the precision at each step, the starting value is computed recursively from the number
+ * with its n * k least significant digits removed, where k is its length divided by 2n (so about half of the digits remain): if s is
+ * the root of those leading digits, (s + 1) * 10^k is an overestimate that is already correct in about half of the digits of the root, so only a few
+ * Newton steps are needed. Small numbers start from 10^ceil(length / n) instead. It throws `zero_degree` if n is zero and
+ * `negative_root` if n is even and the number is negative.
+ *
+ * @param n The degree of the root.
+ * @return bigint The integer n-th root of the current number.
+ */
+bigint bigint::iroot(const uint64_t &n) const
+{
+    if (n == 0)
+        throw zero_degree;
+    if (number_sign == sign::negative)
+    {
+        if (n % 2 == 0)
+            throw negative_root;
+        return -(-*this).iroot(n);
+    }
+    if (number_sign == sign::zero or n == 1)
         return *this;
+    // The number is less than 10^length < 2^(4 * length), so for larger degrees the root is one.
+    if (n >= 4 * digits.size())
+        return bigint(1);
+
+    bigint x;
+    size_t k = digits.size() / (2 * n);
+    if (digits.size() <= thresholds.root_base_case or k == 0)
+    {
+        x.set(1);
+        x.shift_left((digits.size() + n - 1) / n);
+    }
+    else
+    {
+        bigint leading = *this;
+        leading.shift_right(n * k);
+        x = leading.iroot(n);
+        x += bigint(1);
+        x.shift_left(k);
+    }
+
+    const bigint lower_degree(static_cast<int64_t>(n - 1));
+    while (true)
+    {
+        bigint next = *this;
+        next /= power(x, n - 1);
+        next += lower_degree * x;
+        next.divide_small(n);
+        if (!(next < x))
+            return x;
+        x = next;
+    }
+}
+
+/**
+ * @brief Computes the integer square root of the current bigint number, the largest integer whose square does not exceed it.
+ *
+ * @return bigint The integer square root of the current number.
+ */
+bigint bigint::isqrt() const
+{
+    if (number_sign == sign::negative)
+        throw negative_root;
+    return iroot(2);
+}
+
+/**
+ * @brief Checks whether a residue is a square modulo a small integer.
+ *
+ * @param residue The residue to be checked, in the range [0, modulus).
+ * @param modulus A small positive integer.
+ * @return true If there is an integer whose square is congruent to `residue`.
+ * @return false Otherwise.
+ */
+bool bigint::is_square_residue(const uint64_t &residue, const uint64_t &modulus)
+{
+    for (uint64_t x = 0; x < modulus; x++)
+        if ((x * x) % modulus == residue)
+            return true;
+    return false;
+}
+
+/**
+ * @brief Checks whether the current bigint number is a perfect square.
+ *
+ * Before computing the square root, it rejects most non-squares cheaply: the last two digits give the remainder modulo 100, and a single
+ * pass over the digits gives the remainder modulo 9 * 7 * 11 * 13 * 17 * 19 * 23. A perfect square must be a square modulo each of these.
+ *
+ * @return true If the current number is the square of an integer.
+ * @return false Otherwise.
+ */
+bool bigint::is_perfect_square() const
+{
+    if (number_sign == sign::negative)
+        return false;
+    if (number_sign == sign::zero)
+        return true;
+
+    uint64_t last_two = digits[0];
+    if (digits.size() > 1)
+        last_two += static_cast<uint64_t>(digits[1]) * 10;
+    if (!is_square_residue(last_two, 100))
+        return false;
+    const uint64_t moduli[] = {9, 7, 11, 13, 17, 19, 23};
+    uint64_t residue = remainder_small(66927861);
+    for (const uint64_t &modulus : moduli)
+        if (!is_square_residue(residue % modulus, modulus))
+            return false;
+
+    bigint root = isqrt();
+    root *= root;
+    return root == *this;
+}
+
+/**
+ * @brief Finds all the prime numbers up to a limit using the sieve of Eratosthenes.
+ *
+ * @param limit The upper bound (inclusive) of the primes.
+ * @return vector<uint64_t> The primes not greater than `limit`, in increasing order.
+ */
+vector<uint64_t> sieve(const uint64_t &limit)
+{
+    vector<uint64_t> primes;
+    if (limit < 2)
+        return primes;
+    vector<bool> composite(limit + 1, false);
+    for (uint64_t i = 2; i <= limit; i++)
+    {
+        if (composite[i])
+            continue;
+        primes.push_back(i);
+        for (uint64_t j = i * i; j <= limit; j += i)
+            composite[j] = true;
+    }
+    return primes;
+}
+
+/**
+ * @brief Multiplies the bigint numbers in a range of a vector using a balanced product tree.
+ *
+ * The range is split in half, each half is multiplied recursively and the two products are multiplied at the end. Compared to
+ * multiplying the numbers one by one into an accumulator, the two operands of each multiplication have about the same size, and most
+ * of the multiplications are between small numbers. If more than one thread is allowed, the left half of large ranges is computed
+ * in a new thread while the current thread computes the right half.
+ *
+ * @param factors The numbers to be multiplied.
+ * @param first The index of the first number in the range.
+ * @param last The index after the last number in the range.
+ * @param threads The number of threads that may be used.
+ * @return bigint The product of the numbers in the range, which is one if the range is empty.
+ */
+bigint product_tree(const vector<bigint> &factors, const size_t &first, const size_t &last, const size_t &threads)
+{
+    if (first == last)
+        return bigint(1);
+    if (last - first == 1)
+        return factors[first];
+
+    size_t middle = first + (last - first) / 2;
+    bigint result, right;
+    if (threads > 1 and last - first >= bigint::thresholds.parallel_product)
+    {
+        future<bigint> left = async(launch::async, product_tree, cref(factors), first, middle, threads / 2);
+        right = product_tree(factors, middle, last, threads - threads / 2);
+        result = left.get();
     }
     else
     {
-        bigint result;
-        for (size_t i = 0; i < digits.size(); i++)
+        result = product_tree(factors, first, middle, 1);
+        right = product_tree(factors, middle, last, 1);
+    }
+    result *= right;
+    return result;
+}
+
+/**
+ * @brief Multiplies a list of small positive integers.
+ *
+ * The integers are first packed into as few 63-bit words as possible, so that the leaves of the product tree are about the same size.
+ *
+ * @param factors The positive integers to be multiplied.
+ * @param parallel Whether the product tree can be evaluated by multiple threads.
+ * @return bigint The product of the integers.
+ */
+bigint product(const vector<uint64_t> &factors, const bool &parallel)
+{
+    vector<bigint> words;
+    uint64_t word = 1;
+    for (const uint64_t &factor : factors)
+    {
+        if (word > static_cast<uint64_t>(numeric_limits<int64_t>::max()) / factor)
         {
-            uint8_t carry = 0;
-            bigint temp;
-            temp.digits.resize(i, 0);
-            for (size_t j = 0; j < other.digits.size(); j++)
-            {
-                // Start: Cast from int to uint8_t source: https://stackoverflow.com/questions/57746321/implicit-conversion-warning-int-to-int-lookalike
-                uint8_t multiply = static_cast<uint8_t>(digits[i] * other.digits[j] + carry);
-                // End
-                carry = multiply / 10;
-                temp.digits.push_back(multiply % 10);
-            }
-            if (carry > 0)
-                temp.digits.push_back(carry);
-            temp.number_sign = sign::positive;
-            result += temp;
+            words.push_back(bigint(static_cast<int64_t>(word)));
+            word = 1;
         }
-        digits = result.digits;
-        return *this;
+        word *= factor;
     }
+    if (word > 1)
+        words.push_back(bigint(static_cast<int64_t>(word)));
+    size_t threads = parallel ? max<size_t>(thread::hardware_concurrency(), 1) : 1;
+    return product_tree(words, 0, words.size(), threads);
 }
 
 /**
- * @brief Multiplies two bigint numbers.
+ * @brief Computes a product of prime powers from its factorization.
  *
- * @param lhs The left-hand side operand (multiplier).
- * @param rhs The right-hand side operand (multiplicand).
- * @return bigint A copy of the result after multiplication.
+ * Instead of raising each prime to its exponent, the primes are grouped by the bits of their exponents: if P(i) is the product of the
+ * primes whose exponent has the i-th bit set, the result is P(0) * P(1)^2 * P(2)^4 * ..., which is evaluated from the highest bit
+ * by squaring the running result and multiplying it by the next P(i). This way, large multiplications are mostly squarings of
+ * balanced operands.
+ *
+ * @param primes The distinct primes of the factorization.
+ * @param exponents The exponent of each prime in `primes`.
+ * @param parallel Whether the product trees can be evaluated by multiple threads.
+ * @return bigint The product of each prime to the power of its exponent.
  */
-bigint operator*(bigint lhs, const bigint &rhs)
+bigint prime_power_product(const vector<uint64_t> &primes, const vector<uint64_t> &exponents, const bool &parallel)
 {
-    lhs *= rhs;
-    return lhs;
-}
\ No newline at end of file
+    uint64_t max_exponent = 0;
+    for (const uint64_t &exponent : exponents)
+        max_exponent = max(max_exponent, exponent);
+
+    bigint result(1);
+    for (size_t bit = 64; bit > 0; bit--)
+    {
+        uint64_t mask = uint64_t(1) << (bit - 1);
+        if (mask > max_exponent)
+            continue;
+        vector<uint64_t> selected;
+        for (size_t i = 0; i < primes.size(); i++)
+            if (exponents[i] & mask)
+                selected.push_back(primes[i]);
+        result *= result;
+        result *= product(selected, parallel);
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the exponent of a prime in the factorization of n! using Legendre's formula: n / p + n / p^2 + n / p^3 + ...
+ *
+ * @param n A non-negative integer.
+ * @param p A prime number.
+ * @return uint64_t The exponent of `p` in n!.
+ */
+uint64_t legendre_exponent(const uint64_t &n, const uint64_t &p)
+{
+    uint64_t exponent = 0;
+    uint64_t remaining = n;
+    while (remaining > 0)
+    {
+        remaining /= p;
+        exponent += remaining;
+    }
+    return exponent;
+}
+
+/**
+ * @brief Computes the factorial of a non-negative integer.
+ *
+ * The primes up to n are found by a sieve, the exponent of each of them in n! is given by Legendre's formula, and the prime powers
+ * are multiplied by `prime_power_product` using balanced product trees.
+ *
+ * @param n A non-negative integer.
+ * @param parallel Whether the product trees can be evaluated by multiple threads.
+ * @return bigint The factorial of `n`.
+ */
+bigint factorial(const uint64_t &n, const bool &parallel = false)
+{
+    vector<uint64_t> primes = sieve(n);
+    vector<uint64_t> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++)
+        exponents[i] = legendre_exponent(n, primes[i]);
+    return prime_power_product(primes, exponents, parallel);
+}
+
+/**
+ * @brief Computes the binomial coefficient "n choose k".
+ *
+ * The exponent of each prime p in n! / (k! (n - k)!) is the difference of the Legendre exponents of p in the three factorials,
+ * so the coefficient is computed from its factorization without any division.
+ *
+ * @param n A non-negative integer.
+ * @param k A non-negative integer.
+ * @param parallel Whether the product trees can be evaluated by multiple threads.
+ * @return bigint The number of ways to choose `k` elements from `n` elements, which is zero if `k` is greater than `n`.
+ */
+bigint binomial(const uint64_t &n, const uint64_t &k, const bool &parallel = false)
+{
+    if (k > n)
+        return bigint();
+    vector<uint64_t> primes = sieve(n);
+    vector<uint64_t> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++)
+        exponents[i] = legendre_exponent(n, primes[i]) - legendre_exponent(k, primes[i]) - legendre_exponent(n - k, primes[i]);
+    return prime_power_product(primes, exponents, parallel);
+}
+
+/**
+ * @brief Computes the primorial of a non-negative integer, which is the product of all the primes up to that integer.
+ *
+ * @param n A non-negative integer.
+ * @param parallel Whether the product tree can be evaluated by multiple threads.
+ * @return bigint The product of the primes not greater than `n`.
+ */
+bigint primorial(const uint64_t &n, const bool &parallel = false)
+{
+    return product(sieve(n), parallel);
+}
+
+/**
+ * @brief Sets the current bigint number to the lowest digits of the product of the absolute values of two bigint numbers.
+ *
+ * The products of the digits are accumulated in 64-bit columns, one column per digit of the result, and the carries are propagated
+ * once at the end. Only the columns below `limit` are computed, so the cost is proportional to the number of digit pairs that
+ * contribute to them. It is safe for the current object to be one of the operands.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param limit The number of lowest digits of the product to be computed, the result is |a * b| modulo 10^limit.
+ */
+void bigint::multiply_low(const bigint &a, const bigint &b, const size_t &limit)
+{
+    vector<uint64_t> columns;
+    multiply_low(a, b, limit, columns);
+}
+
+/**
+ * @brief Sets the current bigint number to the lowest digits of the product of the absolute values of two bigint numbers, using a
+ * caller-provided buffer for the columns, so that repeated calls do not allocate once the buffer is large enough.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param limit The number of lowest digits of the product to be computed, the result is |a * b| modulo 10^limit.
+ * @param columns The buffer for the 64-bit columns, its previous contents are discarded.
+ */
+void bigint::multiply_low(const bigint &a, const bigint &b, const size_t &limit, vector<uint64_t> &columns)
+{
+    clear_cache();
+    if (a.number_sign == sign::zero or b.number_sign == sign::zero or limit == 0)
+    {
+        number_sign = sign::zero;
+        digits = {0};
+        return;
+    }
+    size_t size = min(limit, a.digits.size() + b.digits.size());
+    columns.assign(size, 0);
+    size_t rows = min(a.digits.size(), size);
+    bigint_progress progress;
+    for (size_t i = 0; i < rows; i++)
+    {
+        progress.step(i, rows);
+        uint64_t digit = a.digits[i];
+        if (digit == 0)
+            continue;
+        size_t end = min(b.digits.size(), size - i);
+        for (size_t j = 0; j < end; j++)
+            columns[i + j] += digit * b.digits[j];
+    }
+    digits.resize(size);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        uint64_t column = columns[i] + carry;
+        digits[i] = static_cast<uint8_t>(column % 10);
+        carry = column / 10;
+    }
+    number_sign = sign::positive;
+    zero_remover();
+}
+
+/**
+ * @brief Splits the absolute value of the current bigint number into its lowest k digits and the rest, so that |x| = high * 10^k + low.
+ *
+ * @param k The number of digits in the low part.
+ * @param low The number formed by the lowest `k` digits.
+ * @param high The number formed by the remaining digits.
+ */
+void bigint::split(const size_t &k, bigint &low, bigint &high) const
+{
+    size_t middle = min(k, digits.size());
+    low.clear_cache();
+    low.digits.assign(digits.begin(), digits.begin() + static_cast<ptrdiff_t>(middle));
+    low.number_sign = sign::positive;
+    low.zero_remover();
+    if (middle == digits.size())
+        high = bigint();
+    else
+    {
+        high.clear_cache();
+        high.digits.assign(digits.begin() + static_cast<ptrdiff_t>(middle), digits.end());
+        high.number_sign = sign::positive;
+    }
+}
+
+/**
+ * @brief Multiplies the absolute values of two bigint numbers using Karatsuba's method.
+ *
+ * Both numbers are split at k digits, a = a1 * 10^k + a0 and b = b1 * 10^k + b0, and the product is
+ * a1 * b1 * 10^(2k) + ((a0 + a1) * (b0 + b1) - a1 * b1 - a0 * b0) * 10^k + a0 * b0, which needs three half-size multiplications
+ * instead of four. They are computed recursively until one of the operands has fewer digits than `thresholds.karatsuba` (but at
+ * least 2, so that both halves are non-empty), where the schoolbook method of `multiply_low` is faster. If one operand is at least twice as long as the other, the longer one is cut
+ * into pieces as long as the shorter one, which are copied one at a time into a reused buffer and multiplied separately. In both
+ * cases, the digits of the result are allocated once, with the length of a plus the length of b, and the partial products are added
+ * into them at their offsets with `add_at`; the recursive products and the halves still have their own digits.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param result The product |a * b|, it must not be the same object as `a` or `b`.
+ */
+void bigint::karatsuba(const bigint &a, const bigint &b, bigint &result)
+{
+    if (a.number_sign == sign::zero or b.number_sign == sign::zero)
+    {
+        result = bigint();
+        return;
+    }
+    const bigint &longer = a.digits.size() >= b.digits.size() ? a : b;
+    const bigint &shorter = a.digits.size() >= b.digits.size() ? b : a;
+    size_t length = shorter.digits.size();
+    if (length < max<size_t>(thresholds.karatsuba, 2))
+    {
+        result.multiply_low(a, b, a.digits.size() + b.digits.size());
+        return;
+    }
+
+    bigint_progress progress;
+    result.clear_cache();
+    result.digits.assign(a.digits.size() + b.digits.size(), 0);
+    result.number_sign = sign::positive;
+    if (longer.digits.size() >= 2 * length)
+    {
+        bigint piece, product;
+        for (size_t offset = 0; offset < longer.digits.size(); offset += length)
+        {
+            progress.step(offset, longer.digits.size());
+            size_t end = min(offset + length, longer.digits.size());
+            piece.clear_cache();
+            piece.digits.assign(longer.digits.begin() + static_cast<ptrdiff_t>(offset), longer.digits.begin() + static_cast<ptrdiff_t>(end));
+            piece.number_sign = sign::positive;
+            piece.zero_remover();
+            karatsuba(piece, shorter, product);
+            result.add_at(product, offset);
+        }
+        result.zero_remover();
+        return;
+    }
+
+    size_t k = longer.digits.size() / 2;
+    bigint a0, a1, b0, b1, z0, z1, z2;
+    a.split(k, a0, a1);
+    b.split(k, b0, b1);
+    progress.step(0, 3);
+    karatsuba(a0, b0, z0);
+    progress.step(1, 3);
+    karatsuba(a1, b1, z2);
+    a0 += a1;
+    b0 += b1;
+    progress.step(2, 3);
+    karatsuba(a0, b0, z1);
+    z1 -= z2;
+    z1 -= z0;
+    result.add_at(z0, 0);
+    result.add_at(z1, k);
+    result.add_at(z2, 2 * k);
+    result.zero_remover();
+}
+
+/**
+ * @brief This class implements modular arithmetic with a fixed positive modulus using Barrett reduction.
+ *
+ * Reducing many numbers by the same modulus with `%` repeats a full long division for every number. Instead, this class precomputes
+ * the reciprocal of the modulus once, and then each reduction only needs two multiplications, digit shifts and at most two subtractions.
+ * Unlike Montgomery reduction, it works with any positive modulus, whether odd or even. The intermediate results are kept in member
+ * buffers that are reused by every call, so an object should not be shared between threads without synchronization.
+ *
+ */
+class bigint_modulus
+{
+public:
+    bigint_modulus(const bigint &);
+    bigint reduce(const bigint &);
+    bigint mulmod(const bigint &, const bigint &);
+    bigint addmod(const bigint &, const bigint &);
+    bigint submod(const bigint &, const bigint &);
+    void reduce(const bigint &, bigint &);
+    void mulmod(const bigint &, const bigint &, bigint &);
+    void addmod(const bigint &, const bigint &, bigint &);
+    void submod(const bigint &, const bigint &, bigint &);
+    const bigint &value() const;
+    /**
+     * @brief Exception thrown when the modulus is zero or negative.
+     *
+     */
+    inline static invalid_argument non_positive = invalid_argument("The modulus must be a positive number!");
+
+private:
+    /**
+     * @brief The modulus m.
+     *
+     */
+    bigint m;
+    /**
+     * @brief The number of digits of the modulus, k.
+     *
+     */
+    size_t length;
+    /**
+     * @brief The precomputed reciprocal of the modulus, floor(10^(2k) / m).
+     *
+     */
+    bigint reciprocal;
+    /**
+     * @brief The power of ten 10^(k + 1), which Barrett reduction computes the remainder modulo.
+     *
+     */
+    bigint wrap;
+    /**
+     * @brief Buffer for the estimated quotient during a reduction.
+     *
+     */
+    bigint quotient;
+    /**
+     * @brief Buffer for the estimated multiple of the modulus during a reduction.
+     *
+     */
+    bigint estimate;
+    /**
+     * @brief Buffer for the result of the current operation, which is swapped into the caller's number at the end.
+     *
+     */
+    bigint result;
+    /**
+     * @brief Buffers for operands that have to be reduced before the operation.
+     *
+     */
+    bigint left, right;
+    /**
+     * @brief Buffer for the columns of `multiply_low`.
+     *
+     */
+    vector<uint64_t> columns;
+    void barrett(bigint &);
+    void to_range(const bigint &, bigint &);
+    void multiply(const bigint &, const bigint &);
+    void store(bigint &);
+};
+
+/**
+ * @brief Construct a new bigint_modulus object and precompute the reciprocal of the modulus.
+ *
+ * @param number A positive bigint number to be used as the modulus. It throws `non_positive` otherwise.
+ */
+bigint_modulus::bigint_modulus(const bigint &number)
+{
+    if (number.number_sign != sign::positive)
+        throw non_positive;
+    m = number;
+    length = m.digits.size();
+    reciprocal.set(1);
+    reciprocal.shift_left(2 * length);
+    reciprocal /= m;
+    wrap.set(1);
+    wrap.shift_left(length + 1);
+    quotient.reserve(2 * length + 2);
+    estimate.reserve(2 * length + 2);
+    result.reserve(2 * length + 1);
+    left.reserve(length + 1);
+    right.reserve(length + 1);
+    columns.reserve(2 * length + 2);
+}
+
+/**
+ * @brief Returns the modulus.
+ *
+ * @return const bigint& A reference to the modulus.
+ */
+const bigint &bigint_modulus::value() const
+{
+    return m;
+}
+
+/**
+ * @brief Reduces a non-negative bigint number less than 10^(2k) modulo m in place, where k is the number of digits of m.
+ *
+ * The quotient x / m is estimated by q = floor(floor(x / 10^(k - 1)) * floor(10^(2k) / m) / 10^(k + 1)), which is at most two less
+ * than the true quotient. Therefore x - q * m is less than 3m < 10^(k + 1), so it is enough to compute it modulo 10^(k + 1), and only
+ * the lowest k + 1 digits of q * m are needed. At most two subtractions of m are needed at the end. The high digits of x are copied
+ * into the `estimate` buffer, and all the products are written into the buffers of the object, so no memory is allocated once they
+ * are large enough.
+ *
+ * @param x A non-negative bigint number less than 10^(2k), which will be replaced by its remainder.
+ */
+void bigint_modulus::barrett(bigint &x)
+{
+    if (m.is_abs_greater(x))
+        return;
+    estimate.clear_cache();
+    estimate.digits.assign(x.digits.begin() + static_cast<ptrdiff_t>(length - 1), x.digits.end());
+    estimate.number_sign = sign::positive;
+    estimate.zero_remover();
+    multiply(estimate, reciprocal);
+    quotient.shift_right(length + 1);
+    estimate.multiply_low(quotient, m, length + 1, columns);
+    if (x.digits.size() > length + 1)
+    {
+        x.digits.resize(length + 1);
+        x.zero_remover();
+    }
+    x -= estimate;
+    if (x.number_sign == sign::negative)
+        x += wrap;
+    while (!m.is_abs_greater(x))
+        x -= m;
+}
+
+/**
+ * @brief Stores the full product of the absolute values of two bigint numbers in the `quotient` buffer.
+ *
+ * Karatsuba's method is used if both operands have at least `thresholds.karatsuba` digits, and otherwise the schoolbook method of
+ * `multiply_low` with the column buffer of the object.
+ *
+ * @param a The first operand, it must not be `quotient`.
+ * @param b The second operand, it must not be `quotient`.
+ */
+void bigint_modulus::multiply(const bigint &a, const bigint &b)
+{
+    if (min(a.digits.size(), b.digits.size()) >= max<size_t>(bigint::thresholds.karatsuba, 2))
+        bigint::karatsuba(a, b, quotient);
+    else
+        quotient.multiply_low(a, b, a.digits.size() + b.digits.size(), columns);
+}
+
+/**
+ * @brief Moves the `result` buffer into a caller's number by swapping their digits, so the digits are not copied.
+ *
+ * @param out The number to store the result in.
+ */
+void bigint_modulus::store(bigint &out)
+{
+    out.clear_cache();
+    out.number_sign = result.number_sign;
+    out.digits.swap(result.digits);
+}
+
+/**
+ * @brief Stores the remainder of a bigint number modulo m, in the range [0, m), in a buffer.
+ *
+ * Numbers with more than 2k digits cannot be handled by Barrett reduction and fall back to long division.
+ *
+ * @param x The bigint number to be reduced.
+ * @param out The buffer to store the remainder in.
+ */
+void bigint_modulus::to_range(const bigint &x, bigint &out)
+{
+    out = x;
+    if (out.number_sign == sign::negative)
+        out.number_sign = sign::positive;
+    if (out.digits.size() > 2 * length)
+        out %= m;
+    else
+        barrett(out);
+    if (x.number_sign == sign::negative and out.number_sign != sign::zero)
+    {
+        out -= m;
+        out.number_sign = sign::positive;
+    }
+}
+
+/**
+ * @brief Computes the remainder of a bigint number modulo m.
+ *
+ * Unlike `%`, the remainder is always in the range [0, m), even if the number is negative.
+ *
+ * @param x The bigint number to be reduced.
+ * @return bigint The remainder of `x` modulo m.
+ */
+bigint bigint_modulus::reduce(const bigint &x)
+{
+    bigint out;
+    reduce(x, out);
+    return out;
+}
+
+/**
+ * @brief Computes the remainder of a bigint number modulo m into a caller-provided number, without allocating once the buffers of
+ * the object and of `out` are large enough.
+ *
+ * @param x The bigint number to be reduced.
+ * @param out The number to store the remainder in, in the range [0, m). It may be `x` itself.
+ */
+void bigint_modulus::reduce(const bigint &x, bigint &out)
+{
+    to_range(x, result);
+    store(out);
+}
+
+/**
+ * @brief Multiplies two bigint numbers modulo m.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return bigint The product of `a` and `b` modulo m, in the range [0, m).
+ */
+bigint bigint_modulus::mulmod(const bigint &a, const bigint &b)
+{
+    bigint out;
+    mulmod(a, b, out);
+    return out;
+}
+
+/**
+ * @brief Multiplies two bigint numbers modulo m into a caller-provided number.
+ *
+ * The operands are expected to be already reduced, in which case their product has at most 2k digits and is reduced by Barrett
+ * reduction. Operands outside of the range [0, m) are reduced first. Large operands are multiplied with Karatsuba's method.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param out The number to store the product modulo m in, in the range [0, m). It may be one of the operands.
+ */
+void bigint_modulus::mulmod(const bigint &a, const bigint &b, bigint &out)
+{
+    if (a.number_sign == sign::negative or b.number_sign == sign::negative or !m.is_abs_greater(a) or !m.is_abs_greater(b))
+    {
+        to_range(a, left);
+        to_range(b, right);
+        mulmod(left, right, out);
+        return;
+    }
+    multiply(a, b);
+    result.digits.swap(quotient.digits);
+    result.number_sign = quotient.number_sign;
+    result.clear_cache();
+    barrett(result);
+    store(out);
+}
+
+/**
+ * @brief Adds two bigint numbers modulo m.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return bigint The sum of `a` and `b` modulo m, in the range [0, m).
+ */
+bigint bigint_modulus::addmod(const bigint &a, const bigint &b)
+{
+    bigint out;
+    addmod(a, b, out);
+    return out;
+}
+
+/**
+ * @brief Adds two bigint numbers modulo m into a caller-provided number.
+ *
+ * The operands are expected to be already reduced, in which case a single subtraction of m is enough. Operands outside of the
+ * range [0, m) are reduced first.
+ *
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param out The number to store the sum modulo m in, in the range [0, m). It may be one of the operands.
+ */
+void bigint_modulus::addmod(const bigint &a, const bigint &b, bigint &out)
+{
+    if (a.number_sign == sign::negative or b.number_sign == sign::negative or !m.is_abs_greater(a) or !m.is_abs_greater(b))
+    {
+        to_range(a, left);
+        to_range(b, right);
+        addmod(left, right, out);
+        return;
+    }
+    result = a;
+    result += b;
+    if (!m.is_abs_greater(result))
+        result -= m;
+    store(out);
+}
+
+/**
+ * @brief Subtracts two bigint numbers modulo m.
+ *
+ * @param a The first operand (minuend).
+ * @param b The second operand (subtrahend).
+ * @return bigint The difference of `a` and `b` modulo m, in the range [0, m).
+ */
+bigint bigint_modulus::submod(const bigint &a, const bigint &b)
+{
+    bigint out;
+    submod(a, b, out);
+    return out;
+}
+
+/**
+ * @brief Subtracts two bigint numbers modulo m into a caller-provided number.
+ *
+ * The operands are expected to be already reduced, in which case a single addition of m is enough. Operands outside of the
+ * range [0, m) are reduced first.
+ *
+ * @param a The first operand (minuend).
+ * @param b The second operand (subtrahend).
+ * @param out The number to store the difference modulo m in, in the range [0, m). It may be one of the operands.
+ */
+void bigint_modulus::submod(const bigint &a, const bigint &b, bigint &out)
+{
+    if (a.number_sign == sign::negative or b.number_sign == sign::negative or !m.is_abs_greater(a) or !m.is_abs_greater(b))
+    {
+        to_range(a, left);
+        to_range(b, right);
+        submod(left, right, out);
+        return;
+    }
+    result = a;
+    result -= b;
+    if (result.number_sign == sign::negative)
+        result += m;
+    store(out);
+}
+
+/**
+ * @brief Forgets the cached hash and string of the current bigint number, it must be called whenever the number changes.
+ *
+ * The string is only exchanged if one is cached, so numbers that do not use `cache_string` do not pay for an atomic read-modify-write
+ * in every kernel. A relaxed load is enough, since the number cannot be changed while other threads are reading it.
+ *
+ */
+void bigint::clear_cache()
+{
+    cached_hash.store(0, memory_order_relaxed);
+    if (cached_string.load(memory_order_relaxed) != nullptr)
+        delete cached_string.exchange(nullptr, memory_order_acq_rel);
+}
+
+/**
+ * @brief Turns the caching of the decimal representation of the current bigint number on or off.
+ *
+ * When it is on, the decimal string is computed by the first call to `to_string()` or `<<` and then reused until the number changes,
+ * which helps numbers that are printed many times. Turning it off frees the cached string.
+ *
+ * @param enabled Whether the decimal string should be cached.
+ */
+void bigint::cache_string(const bool &enabled)
+{
+    string_caching = enabled;
+    delete cached_string.exchange(nullptr, memory_order_acq_rel);
+}
+
+/**
+ * @brief Allocates memory for at least a given number of digits, so that the current bigint number can grow to that length without
+ * reallocations. It does not change the value.
+ *
+ * @param length The number of decimal digits to allocate.
+ */
+void bigint::reserve(const size_t &length)
+{
+    digits.reserve(length);
+}
+
+/**
+ * @brief Frees the memory of the current bigint number that is not used by its digits. It does not change the value.
+ *
+ */
+void bigint::shrink_to_fit()
+{
+    digits.shrink_to_fit();
+}
+
+/**
+ * @brief Returns the number of digits that the current bigint number can hold without a reallocation.
+ *
+ * @return size_t The capacity of the digits.
+ */
+size_t bigint::capacity() const
+{
+    return digits.capacity();
+}
+
+/**
+ * @brief Returns the memory used by the current bigint number in bytes, including the object itself, the allocated digits and the
+ * cached decimal string, if there is one.
+ *
+ * @return size_t The memory usage in bytes.
+ */
+size_t bigint::memory_usage() const
+{
+    size_t usage = sizeof(bigint) + digits.capacity() * sizeof(uint8_t);
+    const string *cached = cached_string.load(memory_order_acquire);
+    if (cached != nullptr)
+        usage += sizeof(string) + cached->capacity() + 1;
+    return usage;
+}
+
+/**
+ * @brief Returns the cached decimal representation of the current bigint number, and computes it if it is not cached yet.
+ *
+ * If several threads compute it at the same time, the first one to store its string with a compare-and-swap wins, and the others
+ * free their own string and return the winner's.
+ *
+ * @return const string* A pointer to the cached string, which is valid until the number changes.
+ */
+const string *bigint::cached_decimal() const
+{
+    const string *cached = cached_string.load(memory_order_acquire);
+    if (cached != nullptr)
+        return cached;
+    const string *computed = new string(decimal_string());
+    if (cached_string.compare_exchange_strong(cached, computed, memory_order_acq_rel, memory_order_acquire))
+        return computed;
+    delete computed;
+    return cached;
+}
+
+/**
+ * @brief Computes a hash of the current bigint number, so that it can be used as a key in unordered containers.
+ *
+ * The digits are read eight at a time as 64-bit words and mixed into four independent lanes with a multiply and xor-shift, so that
+ * the compiler can keep the lanes in parallel (and vectorize them). The lanes, the remaining digits, the number of digits and the sign
+ * are then combined and passed through a final avalanche step. The result is cached in the object, so hashing the same number again
+ * costs O(1) until it is changed.
+ *
+ * @return size_t The hash of the number, equal numbers have equal hashes.
+ */
+size_t bigint::hash() const
+{
+    size_t cached = cached_hash.load(memory_order_relaxed);
+    if (cached != 0)
+        return cached;
+
+    const uint64_t multiplier = 0x9E3779B97F4A7C15;
+    uint64_t lanes[4] = {0x243F6A8885A308D3, 0x13198A2E03707344, 0xA4093822299F31D0, 0x082EFA98EC4E6C89};
+    const uint8_t *data = digits.data();
+    size_t i = 0;
+    for (; i + 32 <= digits.size(); i += 32)
+    {
+        for (size_t lane = 0; lane < 4; lane++)
+        {
+            uint64_t word;
+            memcpy(&word, data + i + 8 * lane, 8);
+            lanes[lane] = (lanes[lane] ^ word) * multiplier;
+            lanes[lane] ^= lanes[lane] >> 29;
+        }
+    }
+    uint64_t h = lanes[0] ^ ((lanes[1] << 16) | (lanes[1] >> 48)) ^ ((lanes[2] << 32) | (lanes[2] >> 32)) ^ ((lanes[3] << 48) | (lanes[3] >> 16));
+    for (; i < digits.size(); i += 8)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data + i, min<size_t>(8, digits.size() - i));
+        h = (h ^ word) * multiplier;
+        h ^= h >> 29;
+    }
+    h ^= static_cast<uint64_t>(digits.size()) * multiplier + static_cast<uint64_t>(number_sign);
+    // Start: Final avalanche step of MurmurHash3. Source: https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    h *= 0xC4CEB93FE53B4E53;
+    h ^= h >> 33;
+    // End
+    if (h == 0)
+        h = 1;
+    cached_hash.store(static_cast<size_t>(h), memory_order_relaxed);
+    return static_cast<size_t>(h);
+}
+
+/**
+ * @brief Specialization of `std::hash` for bigint numbers, so that they can be used as keys in `unordered_map` and `unordered_set`.
+ *
+ */
+template <>
+struct std::hash<bigint>
+{
+    size_t operator()(const bigint &number) const noexcept
+    {
+        return number.hash();
+    }
+};
+
+/**
+ * @brief This class represents an integer in a residue number system, by its remainders modulo many word-size primes.
+ *
+ * Adding, subtracting or multiplying two bigint numbers needs carries that run through all of their digits, but in a residue number
+ * system each operation works on every remainder independently, with no carries at all. This makes long chains of `+`, `-` and `*`
+ * (such as evaluating a polynomial or a determinant) much faster, and the loops over the remainders can be vectorized by the compiler
+ * or split between threads. The only restriction is that the capacity, the number of digits of the largest intermediate value, must
+ * be known in advance: every value is only known modulo the product of the primes, which is chosen to be greater than twice 10^capacity.
+ * At the end, the result is converted back to a bigint number with the Chinese remainder theorem.
+ *
+ */
+class bigint_rns
+{
+public:
+    bigint_rns(const bigint &, const size_t &);
+    bigint_rns &operator+=(const bigint_rns &);
+    bigint_rns &operator-=(const bigint_rns &);
+    bigint_rns &operator*=(const bigint_rns &);
+    bigint to_bigint() const;
+    size_t size() const;
+    /**
+     * @brief Exception thrown when two numbers with different bases (capacities that need different numbers of primes) are combined.
+     *
+     */
+    inline static invalid_argument different_capacity = invalid_argument("The residue number systems of the operands are different!");
+
+private:
+    /**
+     * @brief The primes of a residue number system and the constants used to convert numbers back to bigint.
+     *
+     */
+    struct basis
+    {
+        /**
+         * @brief The primes, all less than 2^31 so that the product of two remainders fits in 64 bits.
+         *
+         */
+        vector<uint64_t> primes;
+        /**
+         * @brief The inverse of the product of the primes before the i-th prime, modulo the i-th prime (used by Garner's algorithm).
+         *
+         */
+        vector<uint64_t> inverses;
+        /**
+         * @brief The product of all the primes.
+         *
+         */
+        bigint product;
+    };
+    /**
+     * @brief The basis of this number, shared by all numbers whose capacities need the same number of primes.
+     *
+     */
+    shared_ptr<const basis> moduli;
+    /**
+     * @brief The remainders of the number modulo each prime of the basis.
+     *
+     */
+    vector<uint64_t> residues;
+    void check_basis(const bigint_rns &) const;
+    static shared_ptr<const basis> get_basis(const size_t &);
+    static uint64_t power_mod(const uint64_t &, const uint64_t &, const uint64_t &);
+    static bool is_prime(const uint64_t &);
+};
+
+/**
+ * @brief Computes a power of a number modulo a prime less than 2^32.
+ *
+ * @param base The base, less than `mod`.
+ * @param exponent The exponent.
+ * @param mod The modulus.
+ * @return uint64_t The remainder of `base` to the power of `exponent` modulo `mod`.
+ */
+uint64_t bigint_rns::power_mod(const uint64_t &base, const uint64_t &exponent, const uint64_t &mod)
+{
+    uint64_t result = 1 % mod;
+    uint64_t square = base % mod;
+    for (uint64_t remaining = exponent; remaining > 0; remaining /= 2)
+    {
+        if (remaining % 2 == 1)
+            result = result * square % mod;
+        square = square * square % mod;
+    }
+    return result;
+}
+
+/**
+ * @brief Checks whether an odd number less than 2^32 is prime, using the Miller-Rabin test with the bases 2, 7 and 61, which is
+ * deterministic for numbers less than 4,759,123,141.
+ *
+ * @param n An odd number greater than 61 and less than 2^32.
+ * @return true If `n` is prime.
+ * @return false If `n` is composite.
+ */
+bool bigint_rns::is_prime(const uint64_t &n)
+{
+    uint64_t odd = n - 1;
+    uint64_t twos = 0;
+    while (odd % 2 == 0)
+    {
+        odd /= 2;
+        twos++;
+    }
+    const uint64_t bases[] = {2, 7, 61};
+    for (const uint64_t &a : bases)
+    {
+        uint64_t x = power_mod(a, odd, n);
+        if (x == 1 or x == n - 1)
+            continue;
+        bool composite = true;
+        for (uint64_t i = 1; i < twos and composite; i++)
+        {
+            x = x * x % n;
+            if (x == n - 1)
+                composite = false;
+        }
+        if (composite)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the basis for a given capacity, made of the largest primes less than 2^31, as few as possible so that their product
+ * is greater than 2 * 10^capacity.
+ *
+ * The primes are taken in decreasing order and their number of digits, log10(p), is added until it exceeds capacity + log10(2). Each
+ * log10(p) is rounded down a little, so rounding errors can only add a prime. Bases are computed once and shared by all numbers whose
+ * capacities need the same number of primes, so that these numbers can be combined. The caches are protected by a mutex, so numbers
+ * can be created in multiple threads.
+ *
+ * @param capacity The maximum number of digits of any value.
+ * @return shared_ptr<const bigint_rns::basis> The basis for the capacity.
+ */
+shared_ptr<const bigint_rns::basis> bigint_rns::get_basis(const size_t &capacity)
+{
+    static mutex cache_mutex;
+    static map<size_t, size_t> counts;
+    static map<size_t, shared_ptr<const basis>> cache;
+    lock_guard<mutex> lock(cache_mutex);
+    auto known = counts.find(capacity);
+    if (known != counts.end())
+        return cache[known->second];
+
+    vector<uint64_t> primes;
+    double digits = 0;
+    for (uint64_t candidate = (uint64_t(1) << 31) - 1; digits <= static_cast<double>(capacity) + log10(2.0); candidate -= 2)
+        if (is_prime(candidate))
+        {
+            primes.push_back(candidate);
+            digits += log10(static_cast<double>(candidate)) - 1e-9;
+        }
+    size_t count = primes.size();
+    counts[capacity] = count;
+    auto found = cache.find(count);
+    if (found != cache.end())
+        return found->second;
+
+    auto created = make_shared<basis>();
+    created->primes = primes;
+    created->inverses.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t p = created->primes[i];
+        uint64_t prefix = 1;
+        for (size_t j = 0; j < i; j++)
+            prefix = prefix * (created->primes[j] % p) % p;
+        // Start: Inverse modulo a prime by Fermat's little theorem. Source: https://cp-algorithms.com/algebra/module-inverse.html
+        created->inverses[i] = power_mod(prefix, p - 2, p);
+        // End
+    }
+    created->product = product(created->primes, false);
+    cache[count] = created;
+    return created;
+}
+
+/**
+ * @brief Construct a new bigint_rns object from a bigint number.
+ *
+ * The basis is chosen by `get_basis` so that the product of its primes is greater than 2 * 10^capacity, so every value with at most
+ * `capacity` digits, positive or negative, has a distinct representation.
+ *
+ * @param number The bigint number to be represented, with at most `capacity` digits.
+ * @param capacity The maximum number of digits of any value computed with this number.
+ */
+bigint_rns::bigint_rns(const bigint &number, const size_t &capacity)
+{
+    moduli = get_basis(capacity);
+    size_t count = moduli->primes.size();
+    residues.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t p = moduli->primes[i];
+        uint64_t r = number.remainder_small(p);
+        residues[i] = (number.number_sign == sign::negative and r != 0) ? p - r : r;
+    }
+}
+
+/**
+ * @brief Returns the number of primes in the residue number system of the current number.
+ *
+ * @return size_t The number of primes.
+ */
+size_t bigint_rns::size() const
+{
+    return residues.size();
+}
+
+/**
+ * @brief Throws `different_capacity` if two numbers do not use the same primes.
+ *
+ * @param other The other operand.
+ */
+void bigint_rns::check_basis(const bigint_rns &other) const
+{
+    if (moduli != other.moduli)
+        throw different_capacity;
+}
+
+/**
+ * @brief Adds another number to the current number, remainder by remainder.
+ *
+ * @param other The other number (summand), with the same capacity.
+ * @return bigint_rns& A reference to the current object after summation.
+ */
+bigint_rns &bigint_rns::operator+=(const bigint_rns &other)
+{
+    check_basis(other);
+    const uint64_t *primes = moduli->primes.data();
+    for (size_t i = 0; i < residues.size(); i++)
+    {
+        uint64_t sum = residues[i] + other.residues[i];
+        residues[i] = sum >= primes[i] ? sum - primes[i] : sum;
+    }
+    return *this;
+}
+
+/**
+ * @brief Subtracts another number from the current number, remainder by remainder.
+ *
+ * @param other The other number (subtrahend), with the same capacity.
+ * @return bigint_rns& A reference to the current object after subtraction.
+ */
+bigint_rns &bigint_rns::operator-=(const bigint_rns &other)
+{
+    check_basis(other);
+    const uint64_t *primes = moduli->primes.data();
+    for (size_t i = 0; i < residues.size(); i++)
+    {
+        uint64_t difference = residues[i] + primes[i] - other.residues[i];
+        residues[i] = difference >= primes[i] ? difference - primes[i] : difference;
+    }
+    return *this;
+}
+
+/**
+ * @brief Multiplies the current number by another, remainder by remainder.
+ *
+ * @param other The other number (multiplicand), with the same capacity.
+ * @return bigint_rns& A reference to the current object after multiplication.
+ */
+bigint_rns &bigint_rns::operator*=(const bigint_rns &other)
+{
+    check_basis(other);
+    const uint64_t *primes = moduli->primes.data();
+    for (size_t i = 0; i < residues.size(); i++)
+        residues[i] = residues[i] * other.residues[i] % primes[i];
+    return *this;
+}
+
+/**
+ * @brief Converts the current number back to a bigint number with the Chinese remainder theorem.
+ *
+ * It uses Garner's algorithm: the number is first written in the mixed radix form v0 + v1 * p0 + v2 * p0 * p1 + ..., where each
+ * digit vi is computed from the remainder modulo the i-th prime using only word-size arithmetic, and then this form is evaluated with
+ * bigint operations from the last digit. Results greater than half of the product of the primes are considered negative.
+ *
+ * @return bigint The value of the current number.
+ */
+bigint bigint_rns::to_bigint() const
+{
+    const vector<uint64_t> &primes = moduli->primes;
+    size_t count = residues.size();
+    vector<uint64_t> mixed(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t p = primes[i];
+        uint64_t prefix = 0;
+        for (size_t j = i; j > 0; j--)
+            prefix = (prefix * (primes[j - 1] % p) + mixed[j - 1]) % p;
+        mixed[i] = (residues[i] + p - prefix) % p * moduli->inverses[i] % p;
+    }
+
+    bigint result;
+    for (size_t i = count; i > 0; i--)
+    {
+        result *= bigint(static_cast<int64_t>(primes[i - 1]));
+        result += bigint(static_cast<int64_t>(mixed[i - 1]));
+    }
+    bigint twice = result;
+    twice += result;
+    if (moduli->product < twice)
+        result -= moduli->product;
+    return result;
+}
+
+/**
+ * @brief Adds two numbers in a residue number system.
+ *
+ * @param lhs The left-hand side operand (summand).
+ * @param rhs The right-hand side operand (summand).
+ * @return bigint_rns A copy of the result after summation.
+ */
+bigint_rns operator+(bigint_rns lhs, const bigint_rns &rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+/**
+ * @brief Subtracts two numbers in a residue number system.
+ *
+ * @param lhs The left-hand side operand (minuend).
+ * @param rhs The right-hand side operand (subtrahend).
+ * @return bigint_rns A copy of the result after subtraction.
+ */
+bigint_rns operator-(bigint_rns lhs, const bigint_rns &rhs)
+{
+    lhs -= rhs;
+    return lhs;
+}
+
+/**
+ * @brief Multiplies two numbers in a residue number system.
+ *
+ * @param lhs The left-hand side operand (multiplier).
+ * @param rhs The right-hand side operand (multiplicand).
+ * @return bigint_rns A copy of the result after multiplication.
+ */
+bigint_rns operator*(bigint_rns lhs, const bigint_rns &rhs)
+{
+    lhs *= rhs;
+    return lhs;
+}
+
+/**
+ * @brief Returns the value of a digit character in the bases up to 36, where the letters (in either case) stand for 10 to 35.
+ *
+ * @param c The character.
+ * @return unsigned The value of the digit, or 36 if it is not a digit in any base.
+ */
+unsigned bigint::digit_value(const char &c)
+{
+    if (c >= '0' and c <= '9')
+        return static_cast<unsigned>(c - '0');
+    if (c >= 'a' and c <= 'z')
+        return static_cast<unsigned>(c - 'a' + 10);
+    if (c >= 'A' and c <= 'Z')
+        return static_cast<unsigned>(c - 'A' + 10);
+    return 36;
+}
+
+/**
+ * @brief Returns the number of digits in a base that are grouped into one word during conversions, which is the largest m such that
+ * base^m is less than a limit.
+ *
+ * @param base A base between 2 and 36.
+ * @param limit The limit of the words.
+ * @return size_t The number of digits in one word.
+ */
+size_t bigint::word_length(const unsigned &base, const uint64_t &limit)
+{
+    size_t length = 1;
+    for (uint64_t word = base; word < limit / base; word *= base)
+        length++;
+    return length;
+}
+
+/**
+ * @brief Combines a range of words (digits in the base W = base^m) into a bigint number, dividing and conquering.
+ *
+ * The range is split so that the low part has a power of two number of words, 2^j, and the result is high * W^(2^j) + low, where
+ * the powers W^(2^j) are computed once by repeated squaring and shared by all calls. Since the two halves have about the same size,
+ * the multiplications use Karatsuba's method, so the conversion is faster than multiplying the number by W word by word.
+ *
+ * @param words The words, from the least significant one.
+ * @param first The index of the first word in the range.
+ * @param last The index after the last word in the range.
+ * @param powers The powers W^(2^j) computed so far, where `powers[0]` is W.
+ * @return bigint The value of the words in the range.
+ */
+bigint bigint::combine_words(const vector<uint64_t> &words, const size_t &first, const size_t &last, vector<bigint> &powers)
+{
+    if (last - first == 1)
+        return bigint(static_cast<int64_t>(words[first]));
+    size_t level = 0;
+    while ((size_t(2) << level) < last - first)
+        level++;
+    while (powers.size() <= level)
+        powers.push_back(powers.back() * powers.back());
+    size_t middle = first + (size_t(1) << level);
+    bigint result = combine_words(words, middle, last, powers);
+    result *= powers[level];
+    result += combine_words(words, first, middle, powers);
+    return result;
+}
+
+/**
+ * @brief Computes floor(10^(2k) / d) for a positive bigint number d with k digits, using Newton's iteration.
+ *
+ * The reciprocal of the highest k/2 + 3 digits of d is computed recursively and shifted into place, which is correct to about k/2
+ * digits. One step of Newton's iteration, x + x * (10^(2k) - d * x) / 10^(2k), doubles the number of correct digits, and the last
+ * few units are fixed by comparing 10^(2k) - d * x with d. Since every step only multiplies, the cost is a few Karatsuba products of
+ * k digits instead of a long division. Short numbers are divided directly.
+ *
+ * @param d A positive number.
+ * @return bigint The reciprocal of d scaled by 10^(2k).
+ */
+bigint bigint::reciprocal(const bigint &d)
+{
+    const bigint one(1);
+    size_t k = d.digits.size();
+    bigint result = one;
+    if (k <= max<size_t>(2 * thresholds.karatsuba, 16))
+    {
+        result.shift_left(2 * k);
+        result /= d;
+        return result;
+    }
+    size_t h = k / 2 + 3;
+    bigint low, high;
+    d.split(k - h, low, high);
+    result = reciprocal(high);
+    result.shift_left(k - h);
+    bigint error = one;
+    error.shift_left(2 * k);
+    error -= d * result;
+    bigint correction = result * error;
+    correction.shift_right(2 * k);
+    result += correction;
+    error = one;
+    error.shift_left(2 * k);
+    error -= d * result;
+    while (error.number_sign == sign::negative)
+    {
+        result -= one;
+        error += d;
+    }
+    while (!d.is_abs_greater(error))
+    {
+        result += one;
+        error -= d;
+    }
+    return result;
+}
+
+/**
+ * @brief Splits a non-negative bigint number into words (digits in the base W = base^m), dividing and conquering, which is the
+ * reverse of `combine_words`.
+ *
+ * A number below W^(2^j) is divided by W^(2^(j-1)), the quotient gives the high 2^(j-1) words and the remainder the low ones, so
+ * the low half is padded with zero words whenever it is shorter. The divisions use Barrett's method with the reciprocals computed
+ * by `reciprocal`: the quotient is estimated from the highest digits of the number times the reciprocal of the highest digits of the
+ * divisor (as many as the quotient needs, and the reciprocal of the whole divisor is kept for the other calls), and it is off by at
+ * most a few units, which are fixed by adding or subtracting the divisor. Numbers with at most `thresholds.conversion_base_case`
+ * digits are packed into limbs of nine decimal digits, which are repeatedly divided by W, since the divisions only pay off for very
+ * long numbers.
+ *
+ * @param number A number below W^(2^level).
+ * @param level The level j of the split, the number is written into 2^j words.
+ * @param powers The powers W^(2^j), where `powers[0]` is W.
+ * @param reciprocals The reciprocals of the powers computed so far by `reciprocal`, or zero for the ones not computed yet.
+ * @param word_base The base W of the words.
+ * @param words The words of the result, from the least significant one, which must be zero where this call writes.
+ * @param first The index of the lowest word of this call.
+ */
+void bigint::split_words(const bigint &number, const size_t &level, const vector<bigint> &powers, vector<bigint> &reciprocals, const uint64_t &word_base, vector<uint64_t> &words, const size_t &first)
+{
+    if (level == 0 or number.digits.size() <= thresholds.conversion_base_case)
+    {
+        const uint64_t limb_base = 1000000000;
+        vector<uint64_t> limbs((number.digits.size() + 8) / 9, 0);
+        for (size_t i = number.digits.size(); i > 0; i--)
+            limbs[limbs.size() - 1 - (i - 1) / 9] = limbs[limbs.size() - 1 - (i - 1) / 9] * 10 + number.digits[i - 1];
+        bigint_progress progress;
+        size_t first_limb = 0;
+        for (size_t w = first; first_limb < limbs.size(); w++)
+        {
+            progress.step(first_limb, limbs.size());
+            uint64_t remainder = 0;
+            for (size_t i = first_limb; i < limbs.size(); i++)
+            {
+                uint64_t current = remainder * limb_base + limbs[i];
+                limbs[i] = current / word_base;
+                remainder = current % word_base;
+            }
+            words[w] = remainder;
+            while (first_limb < limbs.size() and limbs[first_limb] == 0)
+                first_limb++;
+        }
+        return;
+    }
+    const bigint &divisor = powers[level - 1];
+    if (divisor.is_abs_greater(number))
+    {
+        split_words(number, level - 1, powers, reciprocals, word_base, words, first);
+        return;
+    }
+    size_t k = divisor.digits.size();
+    size_t precision = min(k, number.digits.size() - k + 3);
+    bigint_progress progress;
+    progress.step(0, 3);
+    bigint quotient = number;
+    quotient.shift_right(k - 1);
+    if (precision == k)
+    {
+        if (reciprocals[level - 1].number_sign == sign::zero)
+            reciprocals[level - 1] = reciprocal(divisor);
+        quotient *= reciprocals[level - 1];
+    }
+    else
+    {
+        bigint low, high;
+        divisor.split(k - precision, low, high);
+        quotient *= reciprocal(high);
+    }
+    quotient.shift_right(precision + 1);
+    bigint remainder = number;
+    remainder -= quotient * divisor;
+    const bigint one(1);
+    while (remainder.number_sign == sign::negative)
+    {
+        remainder += divisor;
+        quotient -= one;
+    }
+    while (!divisor.is_abs_greater(remainder))
+    {
+        remainder -= divisor;
+        quotient += one;
+    }
+    progress.step(1, 3);
+    split_words(remainder, level - 1, powers, reciprocals, word_base, words, first);
+    progress.step(2, 3);
+    split_words(quotient, level - 1, powers, reciprocals, word_base, words, first + (size_t(1) << (level - 1)));
+}
+
+/**
+ * @brief Creates a bigint number from a string in a base between 2 and 36.
+ *
+ * An optional `+` or `-` sign may precede the digits, and the letters `a` to `z` (in either case) stand for the digits 10 to 35.
+ * Since the base is explicit, leading zeros are allowed. Decimal strings are copied into the digits directly. In other bases, the
+ * digits are first grouped into 60-bit words from the least significant one; in the bases 2, 4, 8, 16 and 32 this is done by packing
+ * the bits of each digit with shifts, and in the other bases by multiplying by the base. Then the words are combined by `combine_words`.
+ * It throws `invalid_base`, `empty_string` or `non_digit` if the base or the string is invalid.
+ *
+ * @param input A string view representing a number in the given base.
+ * @param base The base of the number.
+ * @return bigint The number represented by the string.
+ */
+bigint bigint::from_string(const string_view &input, const unsigned &base)
+{
+    if (base < 2 or base > 36)
+        throw invalid_base;
+    if (input.empty())
+        throw empty_string;
+    size_t start = (input[0] == '+' or input[0] == '-') ? 1 : 0;
+    if (start == input.size())
+        throw non_digit;
+    for (size_t i = start; i < input.size(); i++)
+        if (digit_value(input[i]) >= base)
+            throw non_digit;
+    while (start + 1 < input.size() and input[start] == '0')
+        start++;
+
+    bigint result;
+    if (base == 10)
+        result.try_set(input.substr(start));
+    else
+    {
+        size_t length = word_length(base, uint64_t(1) << 60);
+        unsigned bits = 0;
+        if ((base & (base - 1)) == 0)
+            while ((1u << bits) < base)
+                bits++;
+        size_t digit_count = input.size() - start;
+        vector<uint64_t> words((digit_count + length - 1) / length, 0);
+        for (size_t w = 0; w < words.size(); w++)
+        {
+            size_t end = input.size() - w * length;
+            size_t begin = end - min(length, end - start);
+            uint64_t word = 0;
+            if (bits > 0)
+                for (size_t i = begin; i < end; i++)
+                    word = (word << bits) | digit_value(input[i]);
+            else
+                for (size_t i = begin; i < end; i++)
+                    word = word * base + digit_value(input[i]);
+            words[w] = word;
+        }
+        vector<bigint> powers(1, power(bigint(static_cast<int64_t>(base)), length));
+        result = combine_words(words, 0, words.size(), powers);
+    }
+    if (input[0] == '-' and result.number_sign != sign::zero)
+        result.number_sign = sign::negative;
+    return result;
+}
+
+/**
+ * @brief Writes the digits of the current bigint number into a decimal string, like the output of the insertion operator.
+ *
+ * @return string The decimal representation of the number.
+ */
+string bigint::decimal_string() const
+{
+    if (number_sign == sign::zero)
+        return "0";
+    string output;
+    output.reserve(digits.size() + 1);
+    if (number_sign == sign::negative)
+        output.push_back('-');
+    for (size_t i = digits.size(); i > 0; i--)
+        output.push_back(static_cast<char>('0' + digits[i - 1]));
+    return output;
+}
+
+/**
+ * @brief Converts the current bigint number to a string in a base between 2 and 36, where the digits 10 to 35 are written as lowercase letters.
+ *
+ * Decimal strings are written from the digits directly by `decimal_string`, or taken from the cache if `cache_string` was called.
+ * In other bases, the number is split into words in the base W = base^m (the largest power of the base such that a word and a
+ * limb of nine decimal digits fit in 64 bits) by `split_words`. Numbers longer than `thresholds.conversion_base_case` are divided by
+ * the powers W^(2^j) like `combine_words` multiplies by them, which costs a few Karatsuba products per level instead of dividing the
+ * whole number by W once per word, and shorter ones (or pieces) are divided by W word by word. Each word gives m digits of the
+ * result, and in the bases 2, 4, 8, 16 and 32 these digits are unpacked from its bits with shifts and masks. It throws
+ * `invalid_base` if the base is invalid.
+ *
+ * @param base The base of the result.
+ * @return string The representation of the number in the given base.
+ */
+string bigint::to_string(const unsigned &base) const
+{
+    if (base < 2 or base > 36)
+        throw invalid_base;
+    if (base == 10)
+        return string_caching ? *cached_decimal() : decimal_string();
+    if (number_sign == sign::zero)
+        return "0";
+    string output;
+
+    const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    size_t length = word_length(base, numeric_limits<uint64_t>::max() / 1000000000);
+    uint64_t word_base = 1;
+    for (size_t i = 0; i < length; i++)
+        word_base *= base;
+    unsigned bits = 0;
+    if ((base & (base - 1)) == 0)
+        while ((1u << bits) < base)
+            bits++;
+
+    bigint number = *this;
+    number.number_sign = sign::positive;
+    vector<bigint> powers(1, bigint(static_cast<int64_t>(word_base)));
+    size_t level = 0;
+    if (number.digits.size() > thresholds.conversion_base_case)
+    {
+        while (2 * powers.back().digits.size() - 1 <= number.digits.size())
+        {
+            bigint square = powers.back() * powers.back();
+            if (square.is_abs_greater(number))
+                break;
+            powers.push_back(square);
+        }
+        level = powers.size();
+    }
+    vector<bigint> reciprocals(powers.size());
+    vector<uint64_t> words(number.digits.size() / (powers[0].digits.size() - 1) + 1, 0);
+    split_words(number, level, powers, reciprocals, word_base, words, 0);
+
+    output.assign(words.size() * length + 1, '0');
+    size_t position = output.size();
+    for (const uint64_t &word : words)
+    {
+        uint64_t rest = word;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (bits > 0)
+            {
+                output[--position] = symbols[rest & (base - 1)];
+                rest >>= bits;
+            }
+            else
+            {
+                output[--position] = symbols[rest % base];
+                rest /= base;
+            }
+        }
+    }
+    size_t first = output.find_first_not_of('0');
+    if (number_sign == sign::negative)
+        output[--first] = '-';
+    return output.substr(first);
+}
+
+/**
+ * @brief Runs a bigint computation in a new thread with a cancellation token and a progress callback.
+ *
+ * @param token The token to be checked for cancellation and to store the progress in.
+ * @param on_progress A function to be called from the computing thread with the progress, it may be empty.
+ * @param computation The computation, which is called without arguments.
+ * @return future<T> A future holding the result, or the `bigint::cancelled` exception if it was cancelled.
+ */
+template <typename T, typename F>
+future<T> run_async(const bigint_cancellation &token, const function<void(double)> &on_progress, F computation)
+{
+    return async(launch::async, [token, on_progress, computation]()
+                 {
+                     bigint_progress progress(token, on_progress);
+                     progress.step(0, 1);
+                     T result = computation();
+                     progress.step(1, 1);
+                     return result; });
+}
+
+/**
+ * @brief Multiplies two bigint numbers in a new thread.
+ *
+ * @param lhs The left-hand side operand (multiplier).
+ * @param rhs The right-hand side operand (multiplicand).
+ * @param token A token to cancel the computation and read its progress.
+ * @param on_progress A function to be called from the computing thread with the progress between 0 and 1, it may be empty.
+ * @return future<bigint> A future holding the product.
+ */
+future<bigint> async_multiply(const bigint &lhs, const bigint &rhs, const bigint_cancellation &token = bigint_cancellation(), const function<void(double)> &on_progress = nullptr)
+{
+    return run_async<bigint>(token, on_progress, [lhs, rhs]()
+                             { return lhs * rhs; });
+}
+
+/**
+ * @brief Divides two bigint numbers in a new thread.
+ *
+ * @param lhs The left-hand side operand (dividend).
+ * @param rhs The right-hand side operand (divisor).
+ * @param token A token to cancel the computation and read its progress.
+ * @param on_progress A function to be called from the computing thread with the progress between 0 and 1, it may be empty.
+ * @return future<bigint> A future holding the quotient, or the `bigint::division_by_zero` exception.
+ */
+future<bigint> async_divide(const bigint &lhs, const bigint &rhs, const bigint_cancellation &token = bigint_cancellation(), const function<void(double)> &on_progress = nullptr)
+{
+    return run_async<bigint>(token, on_progress, [lhs, rhs]()
+                             { return lhs / rhs; });
+}
+
+/**
+ * @brief Raises a bigint number to a power in a new thread.
+ *
+ * @param base The bigint number to be raised to a power.
+ * @param exponent A non-negative integer exponent.
+ * @param token A token to cancel the computation and read its progress.
+ * @param on_progress A function to be called from the computing thread with the progress between 0 and 1, it may be empty.
+ * @return future<bigint> A future holding the power.
+ */
+future<bigint> async_power(const bigint &base, const uint64_t &exponent, const bigint_cancellation &token = bigint_cancellation(), const function<void(double)> &on_progress = nullptr)
+{
+    return run_async<bigint>(token, on_progress, [base, exponent]()
+                             { return power(base, exponent); });
+}
+
+/**
+ * @brief Converts a bigint number to a string in a new thread.
+ *
+ * @param number The bigint number to be converted.
+ * @param token A token to cancel the computation and read its progress.
+ * @param on_progress A function to be called from the computing thread with the progress between 0 and 1, it may be empty.
+ * @param base The base of the result, between 2 and 36.
+ * @return future<string> A future holding the representation of the number.
+ */
+future<string> async_to_string(const bigint &number, const bigint_cancellation &token = bigint_cancellation(), const function<void(double)> &on_progress = nullptr, const unsigned &base = 10)
+{
+    return run_async<string>(token, on_progress, [number, base]()
+                             { return number.to_string(base); });
+}
+
+/**
+ * @brief This class loads a large number of decimal bigint numbers from a file or a memory buffer in parallel.
+ *
+ * The numbers (records) are separated by commas or newlines, and spaces, tabs and carriage returns around them are ignored. The
+ * input is split into chunks at record boundaries, and each chunk is parsed by its own thread directly from the buffer into a single
+ * preallocated vector of bigint numbers, with no intermediate strings. Invalid records do not stop the loading: they are left as zero
+ * and reported in `errors`, with their index and position in the input.
+ *
+ */
+class bigint_reader
+{
+public:
+    /**
+     * @brief The description of an invalid record.
+     *
+     */
+    struct record_error
+    {
+        /**
+         * @brief The index of the record, counting from zero.
+         *
+         */
+        size_t record;
+        /**
+         * @brief The position of the first character of the record in the input, in bytes.
+         *
+         */
+        size_t offset;
+        /**
+         * @brief The reason why the record is invalid.
+         *
+         */
+        parse_error error;
+    };
+    void load(const string &, const size_t &threads = 0);
+    void parse(const string_view &, const size_t &threads = 0);
+    const vector<bigint> &values() const;
+    const vector<record_error> &errors() const;
+    /**
+     * @brief Exception thrown when the input file cannot be opened or read.
+     *
+     */
+    inline static runtime_error unreadable_file = runtime_error("The input file cannot be read!");
+
+private:
+    /**
+     * @brief The numbers, one for each record, where invalid records are zero.
+     *
+     */
+    vector<bigint> numbers;
+    /**
+     * @brief The invalid records, in the order of their indices.
+     *
+     */
+    vector<record_error> failures;
+    static bool is_separator(const char &);
+    static size_t count_records(const string_view &, const size_t &, const size_t &);
+    void parse_chunk(const string_view &, const size_t &, const size_t &, const size_t &, vector<record_error> &);
+};
+
+/**
+ * @brief Checks whether a character separates two records.
+ *
+ * @param c The character to be checked.
+ * @return true If it is a comma or a newline.
+ * @return false Otherwise.
+ */
+bool bigint_reader::is_separator(const char &c)
+{
+    return c == ',' or c == '\n';
+}
+
+/**
+ * @brief Counts the records that start in a chunk of the input. Since chunks start after a separator, this is the number of separators in
+ * the chunk, plus one for the last record of the input if it is not blank.
+ *
+ * @param text The whole input.
+ * @param first The position of the first character of the chunk.
+ * @param last The position after the last character of the chunk.
+ * @return size_t The number of records in the chunk.
+ */
+size_t bigint_reader::count_records(const string_view &text, const size_t &first, const size_t &last)
+{
+    size_t count = 0;
+    size_t record_start = first;
+    for (size_t i = first; i < last; i++)
+        if (is_separator(text[i]))
+        {
+            count++;
+            record_start = i + 1;
+        }
+    if (last == text.size() and text.find_first_not_of(" \t\r", record_start) != string_view::npos)
+        count++;
+    return count;
+}
+
+/**
+ * @brief Parses the records of a chunk of the input into the preallocated numbers.
+ *
+ * @param text The whole input.
+ * @param first The position of the first character of the chunk.
+ * @param last The position after the last character of the chunk.
+ * @param index The index of the first record of the chunk.
+ * @param chunk_errors The vector to append the invalid records of the chunk to.
+ */
+void bigint_reader::parse_chunk(const string_view &text, const size_t &first, const size_t &last, const size_t &index, vector<record_error> &chunk_errors)
+{
+    size_t record = index;
+    size_t start = first;
+    while (start < last)
+    {
+        size_t end = start;
+        while (end < text.size() and !is_separator(text[end]))
+            end++;
+        if (end == text.size() and text.find_first_not_of(" \t\r", start) == string_view::npos)
+            break;
+        size_t begin = start;
+        size_t stop = end;
+        while (begin < stop and (text[begin] == ' ' or text[begin] == '\t' or text[begin] == '\r'))
+            begin++;
+        while (stop > begin and (text[stop - 1] == ' ' or text[stop - 1] == '\t' or text[stop - 1] == '\r'))
+            stop--;
+        parse_error error = numbers[record].try_set(text.substr(begin, stop - begin));
+        if (error != parse_error::none)
+            chunk_errors.push_back({record, start, error});
+        record++;
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Parses all the records of a memory buffer, replacing the previous values and errors.
+ *
+ * The buffer is split into one chunk per thread (but at least 64 KiB per chunk), and each chunk boundary is moved forward to just after
+ * the next separator. The records of each chunk are counted in parallel, so the vector of numbers can be allocated once and every
+ * thread knows the index of its first record, and then the chunks are parsed in parallel.
+ *
+ * @param text The input, containing decimal numbers separated by commas or newlines.
+ * @param threads The number of threads to use, or zero to use all the hardware threads.
+ */
+void bigint_reader::parse(const string_view &text, const size_t &threads)
+{
+    const size_t minimum_chunk = 1 << 16;
+    size_t count = threads == 0 ? max<size_t>(thread::hardware_concurrency(), 1) : threads;
+    count = max<size_t>(min(count, text.size() / minimum_chunk), 1);
+
+    vector<size_t> bounds(count + 1, text.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < count; i++)
+    {
+        size_t position = max(text.size() / count * i, bounds[i - 1]);
+        while (position < text.size() and !is_separator(text[position]))
+            position++;
+        bounds[i] = min(position + 1, text.size());
+    }
+
+    vector<size_t> first_record(count + 1, 0);
+    vector<thread> workers;
+    for (size_t i = 0; i < count; i++)
+        workers.emplace_back([&, i]()
+                             { first_record[i + 1] = count_records(text, bounds[i], bounds[i + 1]); });
+    for (thread &worker : workers)
+        worker.join();
+    for (size_t i = 0; i < count; i++)
+        first_record[i + 1] += first_record[i];
+
+    numbers.assign(first_record[count], bigint());
+    vector<vector<record_error>> chunk_errors(count);
+    workers.clear();
+    for (size_t i = 0; i < count; i++)
+        workers.emplace_back([&, i]()
+                             { parse_chunk(text, bounds[i], bounds[i + 1], first_record[i], chunk_errors[i]); });
+    for (thread &worker : workers)
+        worker.join();
+
+    failures.clear();
+    for (const vector<record_error> &chunk : chunk_errors)
+        failures.insert(failures.end(), chunk.begin(), chunk.end());
+}
+
+/**
+ * @brief Loads all the records of a file, replacing the previous values and errors.
+ *
+ * The whole file is read into memory with a single read, and then parsed by `parse`. It throws `unreadable_file` if the file cannot be
+ * opened or read, but invalid records are reported in `errors`.
+ *
+ * @param path The path of the file, containing decimal numbers separated by commas or newlines.
+ * @param threads The number of threads to use, or zero to use all the hardware threads.
+ */
+void bigint_reader::load(const string &path, const size_t &threads)
+{
+    ifstream input(path, ios::binary | ios::ate);
+    if (!input.is_open())
+        throw unreadable_file;
+    streamoff size = input.tellg();
+    if (size < 0)
+        throw unreadable_file;
+    string buffer(static_cast<size_t>(size), '\0');
+    input.seekg(0);
+    if (!input.read(buffer.data(), size))
+        throw unreadable_file;
+    parse(buffer, threads);
+}
+
+/**
+ * @brief Returns the numbers that were loaded, one for each record, in the order of the input. Invalid records are zero.
+ *
+ * @return const vector<bigint>& A reference to the numbers.
+ */
+const vector<bigint> &bigint_reader::values() const
+{
+    return numbers;
+}
+
+/**
+ * @brief Returns the invalid records, in the order of the input.
+ *
+ * @return const vector<bigint_reader::record_error>& A reference to the invalid records.
+ */
+const vector<bigint_reader::record_error> &bigint_reader::errors() const
+{
+    return failures;
+}
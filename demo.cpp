@@ -1,5 +1,6 @@
 #include "bigint.hpp"
 #include <fstream>
+#include <unordered_map>
 using namespace std;
 
 int main()
@@ -191,4 +192,115 @@ int main()
     cout << "a = " << a << '\n';
     cout << "b = " << b << '\n';
     cout << "a * b = " << a * b << '\n'; // -592491728334745991384590780072900008
+
+    cout << "\nDividing two bigint numbers:\n";
+    a.set("-1000000000000000000007");
+    b.set(10);
+    cout << "a = " << a << '\n';
+    cout << "b = " << b << '\n';
+    cout << "a / b = " << a / b << '\n'; // -100000000000000000000
+    cout << "a % b = " << a % b << '\n'; // -7
+    try
+    {
+        a /= bigint(0);
+    }
+    catch (const invalid_argument &error)
+    {
+        cout << "Error: " << error.what() << '\n';
+    }
+
+    cout << "\nPowers and roots of bigint numbers:\n";
+    a = power(bigint(12345), 6);
+    cout << "a = 12345^6 = " << a << '\n';                        // 3539537889086624823140625
+    cout << "isqrt(a) = " << a.isqrt() << '\n';                   // 1881365963625
+    cout << "iroot(a, 3) = " << a.iroot(3) << '\n';               // 152399025
+    cout << "a is a perfect square? " << a.is_perfect_square() << '\n';         // 1
+    cout << "a + 1 is a perfect square? " << (a + bigint(1)).is_perfect_square() << '\n'; // 0
+
+    cout << "\nFactorials, binomial coefficients and primorials:\n";
+    cout << "25! = " << factorial(25) << '\n';                      // 15511210043330985984000000
+    cout << "100 choose 50 = " << binomial(100, 50) << '\n';        // 100891344545564193334812497256
+    cout << "primorial(30) = " << primorial(30) << '\n';            // 6469693230
+    cout << "1000! == 1000! (parallel)? " << (factorial(1000) == factorial(1000, true)) << '\n'; // 1
+
+    cout << "\nReducing bigint numbers by the same modulus:\n";
+    bigint_modulus m(bigint("1000000000000000000000000000000"));
+    a.set("123456789123456789123456789123456789");
+    cout << "m = " << m.value() << '\n';
+    cout << "a = " << a << '\n';
+    cout << "a mod m = " << m.reduce(a) << '\n';           // 789123456789123456789123456789
+    cout << "-a mod m = " << m.reduce(-a) << '\n';         // 210876543210876543210876543211
+    cout << "a * a mod m = " << m.mulmod(a, a) << '\n';    // 820281054720515622620750190521
+    bigint square = m.reduce(a);
+    m.mulmod(square, square, square); // in place, reusing the memory of square
+    cout << "a * a mod m = " << square << '\n';           // 820281054720515622620750190521
+
+    cout << "\nUsing bigint numbers as keys of unordered containers:\n";
+    unordered_map<bigint, string> names;
+    bigint key("340282366920938463463374607431768211456");
+    names[key] = "2^128";
+    cout << key << " is " << names[key] << '\n'; // 2^128
+
+    cout << "\nEvaluating a polynomial in a residue number system:\n";
+    // x^3 - 2x + 7 at x = 10^30 + 1 with Horner's method, every value has at most 100 digits.
+    bigint_rns x(bigint("1000000000000000000000000000001"), 100);
+    bigint_rns polynomial(1, 100);
+    polynomial = polynomial * x + bigint_rns(0, 100);
+    polynomial = polynomial * x - bigint_rns(2, 100);
+    polynomial = polynomial * x + bigint_rns(7, 100);
+    cout << "p(x) = " << polynomial.to_bigint() << '\n'; // 1000000000000000000000000000003000000000000000000000000000001000000000000000000000000000006
+
+    cout << "\nAsynchronous computations:\n";
+    bigint_cancellation token;
+    future<bigint> result = async_power(bigint(7), 20000, token);
+    cout << "7^20000 has " << result.get().to_string().size() << " digits\n"; // 16902
+    bigint_cancellation cancelled;
+    cancelled.cancel();
+    try
+    {
+        async_multiply(a, a, cancelled).get();
+    }
+    catch (const runtime_error &error)
+    {
+        cout << "Error: " << error.what() << '\n';
+    }
+
+    cout << "\nLoading many numbers at once:\n";
+    bigint_reader reader;
+    reader.parse("12, -34\n0\n00,abc\n+7\n");
+    for (const bigint &number : reader.values())
+        cout << number << ' '; // 12 -34 0 0 0 7
+    cout << '\n';
+    for (const bigint_reader::record_error &error : reader.errors())
+        cout << "Record " << error.record << " at byte " << error.offset << " is invalid\n";
+
+    cout << "\nOther bases:\n";
+    bigint dead_beef = bigint::from_string("-DeadBeef", 16);
+    cout << dead_beef << '\n';             // -3735928559
+    cout << dead_beef.to_string(2) << '\n'; // -11011110101011011011111011101111
+    cout << bigint::from_string("0777", 8).to_string(36) << '\n'; // e7
+
+    cout << "\nCaching the decimal string:\n";
+    bigint report = power(bigint(2), 100);
+    report.cache_string();
+    cout << report << '\n';             // 1267650600228229401496703205376 (computed and cached)
+    cout << report.to_string() << '\n'; // 1267650600228229401496703205376 (from the cache)
+    report += 1;
+    cout << report << '\n';             // 1267650600228229401496703205377
+
+    cout << "\nMemory management:\n";
+    bigint accumulator;
+    accumulator.reserve(64);
+    for (int count = 0; count < 1000; count++)
+        accumulator += power(bigint(10), 50);
+    cout << accumulator.capacity() << " digits allocated for " << accumulator.to_string().size() << " digits\n"; // 64 digits allocated for 54 digits
+    accumulator /= power(bigint(10), 50);
+    accumulator.shrink_to_fit();
+    cout << accumulator << " uses " << accumulator.memory_usage() << " bytes\n";
+
+    cout << "\nRandom numbers:\n";
+    mt19937_64 generator(2024);
+    bigint random_number = bigint::random(40, generator);
+    cout << random_number << '\n'; // 40 random digits
+    cout << bigint::random(bigint(-10), bigint(10), generator) << '\n'; // between -10 and 10
 }
@@ -0,0 +1,444 @@
+#include "bigint.hpp"
+#include <chrono>
+#include <random>
+using namespace std;
+
+/**
+ * @brief Measures the average running time of a function, repeating it until at least 50 milliseconds have passed.
+ *
+ * @param function The function to be measured.
+ * @return double The average running time of one call in seconds.
+ */
+template <typename F>
+double measure(const F &function)
+{
+    size_t repetitions = 0;
+    chrono::duration<double> elapsed(0);
+    auto start = chrono::steady_clock::now();
+    while (elapsed.count() < 0.05)
+    {
+        function();
+        repetitions++;
+        elapsed = chrono::steady_clock::now() - start;
+    }
+    return elapsed.count() / static_cast<double>(repetitions);
+}
+
+/**
+ * @brief Finds the smallest size where one level of Karatsuba's method is faster than the schoolbook method.
+ *
+ * For each size, the product of two random numbers is timed once with Karatsuba disabled, and once with the threshold equal to the
+ * size, so that the top level uses Karatsuba's method and the halves use the schoolbook method. The crossover is the first size where
+ * Karatsuba's method wins at that size and at the next one.
+ *
+ * @param generator The random number generator.
+ * @return size_t The best threshold for Karatsuba's method.
+ */
+size_t tune_karatsuba(mt19937_64 &generator)
+{
+    const size_t sizes[] = {16, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512};
+    bool previous_faster = false;
+    size_t previous_size = 0;
+    for (const size_t &size : sizes)
+    {
+        bigint a = bigint::random(size, generator);
+        bigint b = bigint::random(size, generator);
+        bigint::thresholds.karatsuba = numeric_limits<size_t>::max();
+        double schoolbook = measure([&]() { bigint c = a * b; });
+        bigint::thresholds.karatsuba = size;
+        double karatsuba = measure([&]() { bigint c = a * b; });
+        cout << "  " << size << " digits: schoolbook " << schoolbook * 1e6 << " us, karatsuba " << karatsuba * 1e6 << " us\n";
+        bool faster = karatsuba < schoolbook;
+        if (faster and previous_faster)
+            return previous_size;
+        previous_faster = faster;
+        previous_size = size;
+    }
+    return previous_faster ? previous_size : sizes[size(sizes) - 1];
+}
+
+/**
+ * @brief Finds the base case size of `iroot` that gives the fastest square roots for numbers of different sizes.
+ *
+ * @param generator The random number generator.
+ * @return size_t The best base case size.
+ */
+size_t tune_root_base_case(mt19937_64 &generator)
+{
+    const size_t candidates[] = {8, 16, 32, 64, 128, 256};
+    const size_t sizes[] = {50, 200, 800};
+    vector<bigint> numbers;
+    for (const size_t &size : sizes)
+        numbers.push_back(bigint::random(size, generator));
+    size_t best = candidates[0];
+    double best_time = numeric_limits<double>::max();
+    for (const size_t &candidate : candidates)
+    {
+        bigint::thresholds.root_base_case = candidate;
+        double time = 0;
+        for (const bigint &number : numbers)
+            time += measure([&]() { bigint root = number.isqrt(); });
+        cout << "  " << candidate << " digits: " << time * 1e6 << " us\n";
+        if (time < best_time)
+        {
+            best_time = time;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Finds the smallest range of a product tree that is worth a new thread, by timing a parallel factorial.
+ *
+ * @return size_t The best threshold for parallel product trees.
+ */
+size_t tune_parallel_product()
+{
+    const size_t candidates[] = {4, 8, 16, 32, 64, 128};
+    size_t best = candidates[0];
+    double best_time = numeric_limits<double>::max();
+    for (const size_t &candidate : candidates)
+    {
+        bigint::thresholds.parallel_product = candidate;
+        double time = measure([]() { bigint f = factorial(5000, true); });
+        cout << "  " << candidate << " numbers: " << time * 1e3 << " ms\n";
+        if (time < best_time)
+        {
+            best_time = time;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Estimates the piece size below which `to_string` converts numbers word by word instead of splitting them further.
+ *
+ * The crossover is at around a million digits, where a single conversion takes minutes, so it is extrapolated from smaller sizes.
+ * For s = 25000 and 50000, a number with s digits and one with 2s digits are converted word by word, and the one with 2s digits is
+ * also split once into two pieces of s digits, so the division costs the difference between the split and the two pieces. Then both
+ * costs are multiplied by their measured growth per doubling (about 4 for the words and 3 for the division) until the split wins.
+ *
+ * @param generator The random number generator.
+ * @return size_t The best base case of conversions.
+ */
+size_t tune_conversion_base_case(mt19937_64 &generator)
+{
+    size_t size = 25000;
+    double words[3], divisions[2];
+    for (size_t i = 0; i < 3; i++)
+    {
+        bigint number = bigint::random(size << i, generator);
+        bigint::thresholds.conversion_base_case = numeric_limits<size_t>::max();
+        words[i] = measure([&]() { string text = number.to_string(16); });
+        if (i > 0)
+        {
+            bigint::thresholds.conversion_base_case = size << (i - 1);
+            double split = measure([&]() { string text = number.to_string(16); });
+            divisions[i - 1] = max(split - 2 * words[i - 1], 1e-6);
+            cout << "  " << (size << i) << " digits: words " << words[i] * 1e3 << " ms, split " << split * 1e3 << " ms\n";
+        }
+    }
+    double word_growth = words[2] / words[1], division_growth = divisions[1] / divisions[0];
+    double half = words[1], whole = words[2], division = divisions[1];
+    size *= 2;
+    for (size_t doubling = 0; doubling < 16 and division + 2 * half >= whole; doubling++)
+    {
+        half = whole;
+        whole *= word_growth;
+        division *= division_growth;
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * @brief Compares the absolute values of two decimal strings without signs or leading zeros, the reference for `<`.
+ *
+ * @return int Negative, zero or positive if a is less than, equal to or greater than b.
+ */
+int reference_compare(const string &a, const string &b)
+{
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    return a.compare(b);
+}
+
+/**
+ * @brief Adds two decimal strings without signs, digit by digit, the reference for `+=`.
+ */
+string reference_add(const string &a, const string &b)
+{
+    string sum;
+    int carry = 0;
+    for (size_t i = 0; i < max(a.size(), b.size()) or carry > 0; i++)
+    {
+        int digit = carry;
+        if (i < a.size())
+            digit += a[a.size() - 1 - i] - '0';
+        if (i < b.size())
+            digit += b[b.size() - 1 - i] - '0';
+        sum.push_back(static_cast<char>('0' + digit % 10));
+        carry = digit / 10;
+    }
+    return string(sum.rbegin(), sum.rend());
+}
+
+/**
+ * @brief Subtracts a smaller decimal string from a greater one, without signs, digit by digit, the reference for `-=`.
+ */
+string reference_subtract(const string &a, const string &b)
+{
+    string difference;
+    int borrow = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        int digit = a[a.size() - 1 - i] - '0' - borrow;
+        if (i < b.size())
+            digit -= b[b.size() - 1 - i] - '0';
+        borrow = digit < 0 ? 1 : 0;
+        difference.push_back(static_cast<char>('0' + digit + 10 * borrow));
+    }
+    while (difference.size() > 1 and difference.back() == '0')
+        difference.pop_back();
+    return string(difference.rbegin(), difference.rend());
+}
+
+/**
+ * @brief Multiplies two decimal strings without signs with the schoolbook method, one digit at a time, the reference for `*=`.
+ */
+string reference_multiply(const string &a, const string &b)
+{
+    vector<int> product(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        int carry = 0;
+        for (size_t j = 0; j < b.size() or carry > 0; j++)
+        {
+            int digit = product[i + j] + carry;
+            if (j < b.size())
+                digit += (a[a.size() - 1 - i] - '0') * (b[b.size() - 1 - j] - '0');
+            product[i + j] = digit % 10;
+            carry = digit / 10;
+        }
+    }
+    while (product.size() > 1 and product.back() == 0)
+        product.pop_back();
+    string result;
+    for (size_t i = product.size(); i > 0; i--)
+        result.push_back(static_cast<char>('0' + product[i - 1]));
+    return result;
+}
+
+/**
+ * @brief Converts a decimal string without sign to another base by repeated division by the base, the reference for `to_string(base)`.
+ */
+string reference_to_base(string number, const unsigned &base)
+{
+    const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    string result;
+    while (number != "0")
+    {
+        string quotient;
+        unsigned remainder = 0;
+        for (const char &c : number)
+        {
+            remainder = remainder * 10 + static_cast<unsigned>(c - '0');
+            if (!quotient.empty() or remainder >= base)
+                quotient.push_back(static_cast<char>('0' + remainder / base));
+            remainder %= base;
+        }
+        result.push_back(symbols[remainder]);
+        number = quotient.empty() ? "0" : quotient;
+    }
+    return result.empty() ? "0" : string(result.rbegin(), result.rend());
+}
+
+/**
+ * @brief Adds two signed decimal strings with the references, so that the results can be compared with `+` and `-`.
+ */
+string reference_signed_add(const string &a, const string &b)
+{
+    bool a_negative = a[0] == '-', b_negative = b[0] == '-';
+    string a_abs = a.substr(a_negative), b_abs = b.substr(b_negative);
+    if (a_negative == b_negative)
+        return (a_negative and a_abs != "0" ? "-" : "") + reference_add(a_abs, b_abs);
+    int order = reference_compare(a_abs, b_abs);
+    if (order == 0)
+        return "0";
+    if (order > 0)
+        return (a_negative ? "-" : "") + reference_subtract(a_abs, b_abs);
+    return (b_negative ? "-" : "") + reference_subtract(b_abs, a_abs);
+}
+
+/**
+ * @brief Cross-checks the fast paths of bigint against the simple references above on random numbers of many sizes.
+ *
+ * For every pair of sizes, random numbers with random signs are multiplied, added, subtracted, compared, printed in the bases 10, 2, 16
+ * and 36 and parsed back, and every result is compared with the reference. The checks run with the current thresholds and again with
+ * the tiny Karatsuba thresholds 4 and 2, which are also used as the conversion base case, so that the recursion, the splitting of
+ * unbalanced operands and the divide and conquer conversion are also exercised on small numbers.
+ *
+ * @param rounds The number of random pairs for each pair of sizes.
+ * @param generator The random number generator.
+ * @return size_t The number of mismatches, which are also printed.
+ */
+size_t check(const size_t &rounds, mt19937_64 &generator)
+{
+    const size_t sizes[] = {1, 2, 9, 18, 19, 20, 50, 95, 96, 97, 200, 1000};
+    const size_t karatsuba_thresholds[] = {bigint::thresholds.karatsuba, 4, 2};
+    const size_t conversion_base_case = bigint::thresholds.conversion_base_case;
+    size_t mismatches = 0;
+    auto expect = [&](const bool &passed, const string &operation, const string &a, const string &b)
+    {
+        if (passed)
+            return;
+        mismatches++;
+        cout << "  Mismatch in " << operation << " of " << a.size() << " and " << b.size() << " characters:\n    " << a << "\n    " << b << '\n';
+    };
+    for (const size_t &threshold : karatsuba_thresholds)
+    {
+        bigint::thresholds.karatsuba = threshold;
+        bigint::thresholds.conversion_base_case = threshold == karatsuba_thresholds[0] ? conversion_base_case : threshold;
+        cout << "  Karatsuba threshold " << threshold << '\n';
+        for (const size_t &a_size : sizes)
+            for (const size_t &b_size : sizes)
+                for (size_t round = 0; round < rounds; round++)
+                {
+                    bigint a = bigint::random(a_size, generator), b = bigint::random(b_size, generator);
+                    if (generator() % 2)
+                        a = -a;
+                    if (generator() % 2)
+                        b = -b;
+                    if (round == 0)
+                        b = a;
+                    string a_text = a.to_string(), b_text = b.to_string();
+                    bool a_negative = a_text[0] == '-', b_negative = b_text[0] == '-';
+                    string a_abs = a_text.substr(a_negative), b_abs = b_text.substr(b_negative);
+                    string negated_b = b_negative ? b_abs : "-" + b_abs;
+
+                    string product = reference_multiply(a_abs, b_abs);
+                    if (product != "0" and a_negative != b_negative)
+                        product = "-" + product;
+                    expect((a * b).to_string() == product, "*", a_text, b_text);
+                    expect((a + b).to_string() == reference_signed_add(a_text, b_text), "+", a_text, b_text);
+                    expect((a - b).to_string() == reference_signed_add(a_text, negated_b), "-", a_text, b_text);
+
+                    int order = reference_compare(a_abs, b_abs);
+                    if (a_negative != b_negative)
+                        order = a_negative ? -1 : 1;
+                    else if (a_negative)
+                        order = -order;
+                    expect((a < b) == (order < 0) and (a == b) == (order == 0), "comparison", a_text, b_text);
+
+                    expect(bigint(a_text) == a, "parsing", a_text, b_text);
+                    for (const unsigned &base : {2u, 16u, 36u})
+                    {
+                        string text = (a_negative ? "-" : "") + reference_to_base(a_abs, base);
+                        expect(a.to_string(base) == text, "printing in base " + to_string(base), a_text, b_text);
+                        expect(bigint::from_string(text, base) == a, "parsing in base " + to_string(base), a_text, b_text);
+                    }
+                }
+    }
+    bigint::thresholds.karatsuba = karatsuba_thresholds[0];
+    bigint::thresholds.conversion_base_case = conversion_base_case;
+    return mismatches;
+}
+
+/**
+ * @brief Checks that printing and parsing in base 16 grow slower than quadratically, by timing them for doubling sizes.
+ *
+ * The conversion base case is lowered so that these sizes are divided and conquered in both directions. Each time is the best of
+ * three measurements, and a growth of 3.5 or more per doubling (4 is quadratic, and Karatsuba's method gives about 3) is a failure.
+ *
+ * @param generator The random number generator.
+ * @return size_t The number of doublings that grew too fast, which are also printed.
+ */
+size_t check_scaling(mt19937_64 &generator)
+{
+    const size_t sizes[] = {10000, 20000, 40000};
+    const size_t conversion_base_case = bigint::thresholds.conversion_base_case;
+    bigint::thresholds.conversion_base_case = 1000;
+    size_t failures = 0;
+    double previous_print = 0, previous_parse = 0;
+    for (const size_t &size : sizes)
+    {
+        bigint number = bigint::random(size, generator);
+        string text = number.to_string(16);
+        auto print = [&]() { string printed = number.to_string(16); };
+        auto parse = [&]() { bigint parsed = bigint::from_string(text, 16); };
+        double print_time = min({measure(print), measure(print), measure(print)});
+        double parse_time = min({measure(parse), measure(parse), measure(parse)});
+        cout << "  " << size << " digits: print " << print_time * 1e3 << " ms, parse " << parse_time * 1e3 << " ms";
+        if (previous_print > 0)
+        {
+            double print_growth = print_time / previous_print, parse_growth = parse_time / previous_parse;
+            cout << " (growth " << print_growth << " and " << parse_growth << ')';
+            if (print_growth >= 3.5 or parse_growth >= 3.5)
+            {
+                failures++;
+                cout << " too fast";
+            }
+        }
+        cout << '\n';
+        previous_print = print_time;
+        previous_parse = parse_time;
+    }
+    bigint::thresholds.conversion_base_case = conversion_base_case;
+    return failures;
+}
+
+/**
+ * @brief Benchmarks the algorithm crossovers of bigint on the current machine and writes them to a tuning profile.
+ *
+ * Usage: `tune [profile]`, where the profile defaults to `bigint.tuning`. To use the profile, set the `BIGINT_TUNING` environment
+ * variable to its path before running a program that uses bigint, or call `bigint::thresholds.load(path)`. With `tune --check [rounds]`,
+ * it cross-checks the arithmetic against the references and the growth of base conversions instead, and exits with 1 if any result
+ * differs or any conversion grows quadratically.
+ */
+int main(int argc, char *argv[])
+{
+    mt19937_64 generator(20240101);
+    if (argc > 1 and string(argv[1]) == "--check")
+    {
+        size_t rounds = argc > 2 ? stoul(argv[2]) : 3;
+        cout << "Checking the arithmetic against the references:\n";
+        size_t mismatches = check(rounds, generator);
+        cout << mismatches << " mismatches\n";
+        cout << "Checking the growth of base conversions:\n";
+        size_t failures = check_scaling(generator);
+        cout << failures << " failures\n";
+        return mismatches == 0 and failures == 0 ? 0 : 1;
+    }
+
+    string path = argc > 1 ? argv[1] : "bigint.tuning";
+    bigint::tuning tuned;
+
+    cout << "Tuning the Karatsuba multiplication threshold:\n";
+    tuned.karatsuba = tune_karatsuba(generator);
+    bigint::thresholds.karatsuba = tuned.karatsuba;
+
+    cout << "Tuning the base case of integer roots:\n";
+    tuned.root_base_case = tune_root_base_case(generator);
+    bigint::thresholds.root_base_case = tuned.root_base_case;
+
+    cout << "Tuning the base case of conversions:\n";
+    tuned.conversion_base_case = tune_conversion_base_case(generator);
+
+    if (thread::hardware_concurrency() > 1)
+    {
+        cout << "Tuning the parallel product tree threshold:\n";
+        tuned.parallel_product = tune_parallel_product();
+    }
+
+    bigint::thresholds = tuned;
+    if (!tuned.save(path))
+    {
+        cout << "Error: could not write the tuning profile to " << path << '\n';
+        return 1;
+    }
+    cout << "karatsuba = " << tuned.karatsuba << ", root_base_case = " << tuned.root_base_case
+         << ", parallel_product = " << tuned.parallel_product << ", conversion_base_case = " << tuned.conversion_base_case << '\n';
+    cout << "Wrote the tuning profile to " << path << '\n';
+}